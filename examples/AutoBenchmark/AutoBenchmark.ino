@@ -0,0 +1,439 @@
+/*
+ * A program which measures the CPU time consumed by the methods of each of the
+ * AceSegmentWriter classes. The Writer classes write into a StubModule, so the
+ * numbers measure the Writer classes themselves, not the time taken to send
+ * the patterns to an LED controller chip.
+ *
+ * Each benchmark calls the method NUM_ITERATIONS times, subtracts the time of
+ * an empty loop, and prints the average duration of a single call in
+ * microseconds. If the CPU frequency is known through F_CPU, the equivalent
+ * number of CPU cycles is printed as well.
+ *
+ * The program can also be compiled and run on Linux or MacOS using EpoxyDuino,
+ * which is useful to track regressions on a build machine.
+ */
+
+#include <Arduino.h>
+#include <AceSegmentWriter.h>
+using namespace ace_segment;
+
+#if defined(ARDUINO_ARCH_AVR)
+const uint16_t NUM_ITERATIONS = 1000;
+#else
+const uint16_t NUM_ITERATIONS = 10000;
+#endif
+
+const uint8_t NUM_DIGITS = 4;
+
+// Same as the StubModule in MemoryBenchmark. It has the same public interface
+// as AceSegment's LedModule, without depending on the AceSegment library.
+class StubModule {
+  public:
+    StubModule() : mNumDigits(NUM_DIGITS) {}
+
+    uint8_t size() const { return mNumDigits; }
+
+    void setPatternAt(uint8_t pos, uint8_t pattern) {
+      mPatterns[pos] = pattern;
+    }
+
+    uint8_t getPatternAt(uint8_t pos) const {
+      return mPatterns[pos];
+    }
+
+    void setBrightness(uint8_t brightness) {
+      mBrightness = brightness;
+    }
+
+    uint8_t getBrightness() const {
+      return mBrightness;
+    }
+
+    void setDecimalPointAt(uint8_t pos, bool state = true) {
+      if (pos >= size()) return;
+      if (state) {
+        mPatterns[pos] |= 0x80;
+      } else {
+        mPatterns[pos] &= ~0x80;
+      }
+    }
+
+  private:
+    uint8_t mPatterns[NUM_DIGITS];
+    uint8_t mNumDigits;
+    uint8_t mBrightness;
+};
+
+StubModule stubModule;
+PatternWriter<StubModule> patternWriter(stubModule);
+NumberWriter<StubModule> numberWriter(patternWriter);
+ClockWriter<StubModule> clockWriter(numberWriter);
+IncrementalClockWriter<StubModule> incrementalClockWriter(clockWriter);
+CounterWriter<StubModule> counterWriter(numberWriter, NUM_DIGITS);
+CachedNumberWriter<StubModule> cachedNumberWriter(numberWriter);
+TemperatureWriter<StubModule> temperatureWriter(numberWriter);
+CharWriter<StubModule> charWriter(patternWriter);
+StringWriter<StubModule> stringWriter(charWriter);
+LevelWriter<StubModule> levelWriter(patternWriter);
+StringScroller<StubModule> stringScroller(charWriter);
+
+// Writers which read the patterns from RAM instead of flash.
+NumberWriter<StubModule, 0, RamStorage> ramNumberWriter(patternWriter);
+CharWriter<StubModule, 0, RamStorage> ramCharWriter(patternWriter);
+
+// A volatile integer to prevent the compiler from optimizing away the code
+// inside the benchmark loops.
+volatile uint16_t disableCompilerOptimization = 0;
+
+// Time of the empty loop, subtracted from every benchmark.
+uint32_t emptyLoopMicros;
+
+//-----------------------------------------------------------------------------
+// Benchmark functions. Each is called with the loop counter, which is
+// scrambled into numbers with varying number of digits.
+//-----------------------------------------------------------------------------
+
+typedef void (*BenchmarkFunc)(uint16_t i);
+
+static uint16_t scramble(uint16_t i) {
+  return i * 61;
+}
+
+void emptyLoop(uint16_t i) {
+  disableCompilerOptimization = scramble(i);
+}
+
+void writePattern(uint16_t i) {
+  patternWriter.home();
+  patternWriter.writePattern((uint8_t) scramble(i));
+  disableCompilerOptimization = stubModule.getPatternAt(0);
+}
+
+void writePatterns(uint16_t /*i*/) {
+  static const uint8_t PATTERNS[NUM_DIGITS] = {
+    kPattern1, kPattern2, kPattern3, kPattern4
+  };
+  patternWriter.home();
+  patternWriter.writePatterns(PATTERNS, NUM_DIGITS);
+  disableCompilerOptimization = stubModule.getPatternAt(0);
+}
+
+void clear(uint16_t /*i*/) {
+  patternWriter.clear();
+  disableCompilerOptimization = stubModule.getPatternAt(0);
+}
+
+// The decimal conversion using '/' which was used by NumberWriter before the
+// division-free conversion. Retained here for comparison.
+uint8_t toDecimalDivision(uint16_t num, digit_t buf[], uint8_t bufSize) {
+  uint8_t pos = bufSize;
+  while (true) {
+    if (num < 10) {
+      buf[--pos] = num;
+      break;
+    }
+    uint16_t quot = num / 10;
+    buf[--pos] = num - quot * 10;
+    num = quot;
+  }
+  return pos;
+}
+
+void toDecimalUsingDivision(uint16_t i) {
+  digit_t buf[5];
+  uint8_t start = toDecimalDivision(scramble(i), buf, 5);
+  disableCompilerOptimization = buf[start];
+}
+
+void toDecimalUsingReciprocal(uint16_t i) {
+  digit_t buf[5];
+  uint8_t start = internal::toDecimal(scramble(i), buf, 5);
+  disableCompilerOptimization = buf[start];
+}
+
+void writeUnsignedDecimal(uint16_t i) {
+  numberWriter.home();
+  numberWriter.writeUnsignedDecimal(scramble(i));
+  disableCompilerOptimization = stubModule.getPatternAt(0);
+}
+
+void writeUnsignedDecimalRam(uint16_t i) {
+  ramNumberWriter.home();
+  ramNumberWriter.writeUnsignedDecimal(scramble(i));
+  disableCompilerOptimization = stubModule.getPatternAt(0);
+}
+
+void writeSignedDecimal(uint16_t i) {
+  numberWriter.home();
+  numberWriter.writeSignedDecimal((int16_t) scramble(i));
+  disableCompilerOptimization = stubModule.getPatternAt(0);
+}
+
+// A sensor value which changes once every 100 calls.
+void writeSignedDecimalCached(uint16_t i) {
+  numberWriter.home();
+  cachedNumberWriter.writeSignedDecimal((int16_t) (i / 100) - 5);
+  disableCompilerOptimization = stubModule.getPatternAt(0);
+}
+
+void writeDec2(uint16_t i) {
+  numberWriter.home();
+  numberWriter.writeDec2(i % 100);
+  disableCompilerOptimization = stubModule.getPatternAt(0);
+}
+
+void writeDec4(uint16_t i) {
+  numberWriter.home();
+  numberWriter.writeDec4(i % 10000);
+  disableCompilerOptimization = stubModule.getPatternAt(0);
+}
+
+static float scrambleFloat(uint16_t i) {
+  return (int16_t) scramble(i) / 100.0f;
+}
+
+// The implementation of NumberWriter::writeFloat() before v0.6, which
+// formatted the float into a string using the Print class, then parsed the
+// string using writeChar(). Retained here for comparison.
+void writeFloatUsingPrint(uint16_t i) {
+  numberWriter.home();
+  ace_common::PrintStr<16> buf;
+  buf.print(scrambleFloat(i), 2);
+  for (const char *s = buf.cstr(); *s != '\0'; s++) {
+    numberWriter.writeChar(*s);
+  }
+  disableCompilerOptimization = stubModule.getPatternAt(0);
+}
+
+void writeFloat(uint16_t i) {
+  numberWriter.home();
+  numberWriter.writeFloat(scrambleFloat(i), 2);
+  disableCompilerOptimization = stubModule.getPatternAt(0);
+}
+
+void writeFloatExp(uint16_t i) {
+  numberWriter.home();
+  numberWriter.writeFloatExp(scrambleFloat(i) * 1e6f, 1);
+  disableCompilerOptimization = stubModule.getPatternAt(0);
+}
+
+void writeFloatFit(uint16_t i) {
+  numberWriter.home();
+  numberWriter.writeFloatFit(scrambleFloat(i), 4);
+  disableCompilerOptimization = stubModule.getPatternAt(0);
+}
+
+void writeHourMinute24(uint16_t i) {
+  clockWriter.home();
+  clockWriter.writeHourMinute24(i % 24, i % 60);
+  disableCompilerOptimization = stubModule.getPatternAt(0);
+}
+
+// Advance the clock by one second. The minute digits are rewritten once every
+// 60 calls, and only the digits which changed.
+void tickIncrementalClock(uint16_t /*i*/) {
+  incrementalClockWriter.tick();
+  disableCompilerOptimization = stubModule.getPatternAt(0);
+}
+
+// Count from 0 to 9999 by converting every number into digits, for comparison
+// with CounterWriter.
+void writeCounterUsingDivision(uint16_t i) {
+  numberWriter.home();
+  numberWriter.writeDec4(i % 10000);
+  disableCompilerOptimization = stubModule.getPatternAt(0);
+}
+
+void incrementCounter(uint16_t /*i*/) {
+  counterWriter.increment();
+  disableCompilerOptimization = stubModule.getPatternAt(0);
+}
+
+void decrementCounter(uint16_t /*i*/) {
+  counterWriter.decrement();
+  disableCompilerOptimization = stubModule.getPatternAt(0);
+}
+
+void writeTempDegC(uint16_t i) {
+  temperatureWriter.home();
+  temperatureWriter.writeTempDegC((int16_t) (i % 200) - 100);
+  disableCompilerOptimization = stubModule.getPatternAt(0);
+}
+
+void writeChar(uint16_t i) {
+  charWriter.home();
+  charWriter.writeChar(' ' + (i % 95));
+  disableCompilerOptimization = stubModule.getPatternAt(0);
+}
+
+void writeCharRam(uint16_t i) {
+  ramCharWriter.home();
+  ramCharWriter.writeChar(' ' + (i % 95));
+  disableCompilerOptimization = stubModule.getPatternAt(0);
+}
+
+void writeString(uint16_t /*i*/) {
+  stringWriter.home();
+  stringWriter.writeString("Ab.c");
+  disableCompilerOptimization = stubModule.getPatternAt(0);
+}
+
+void writeLevel(uint16_t i) {
+  levelWriter.writeLevel(i % (2 * NUM_DIGITS + 1));
+  disableCompilerOptimization = stubModule.getPatternAt(0);
+}
+
+void initMarquee() {
+  stringScroller.initScrollLeft(
+      F("The quick brown fox jumps over the lazy dog"));
+}
+
+// Scroll a long marquee string, restarting when the scrolling is done.
+void scrollLeft(uint16_t /*i*/) {
+  if (stringScroller.scrollLeft()) {
+    initMarquee();
+  }
+  disableCompilerOptimization = stubModule.getPatternAt(0);
+}
+
+void initMarqueeRight() {
+  stringScroller.initScrollRight(
+      F("The quick brown fox jumps over the lazy dog"));
+}
+
+// Scroll a long marquee string to the right, restarting when it is done.
+void scrollRight(uint16_t /*i*/) {
+  if (stringScroller.scrollRight()) {
+    initMarqueeRight();
+  }
+  disableCompilerOptimization = stubModule.getPatternAt(0);
+}
+
+//-----------------------------------------------------------------------------
+
+uint32_t timeLoop(BenchmarkFunc func) {
+  uint32_t startMicros = micros();
+  for (uint16_t i = 0; i < NUM_ITERATIONS; i++) {
+    func(i);
+  }
+  return micros() - startMicros;
+}
+
+void printHeader() {
+  Serial.println(
+      F("+------------------------------------------+--------+--------+"));
+  Serial.println(
+      F("| Method                                   | micros | cycles |"));
+  Serial.println(
+      F("|------------------------------------------+--------+--------|"));
+}
+
+void printFooter() {
+  Serial.println(
+      F("+------------------------------------------+--------+--------+"));
+}
+
+// Print the name padded to 40 characters.
+void printName(const __FlashStringHelper* name) {
+  Serial.print(F("| "));
+  uint8_t len = Serial.print(name);
+  while (len++ < 40) Serial.print(' ');
+  Serial.print(F(" | "));
+}
+
+// Print `value/1000` with 3 decimal places, right justified in 6 characters.
+void printMillisFraction(uint32_t value) {
+  uint32_t whole = value / 1000;
+  uint16_t frac = value % 1000;
+  if (whole < 10) Serial.print(' ');
+  Serial.print(whole);
+  Serial.print('.');
+  if (frac < 100) Serial.print('0');
+  if (frac < 10) Serial.print('0');
+  Serial.print(frac);
+}
+
+void runBenchmark(const __FlashStringHelper* name, BenchmarkFunc func) {
+  uint32_t elapsedMicros = timeLoop(func);
+  elapsedMicros = (elapsedMicros > emptyLoopMicros)
+      ? elapsedMicros - emptyLoopMicros
+      : 0;
+  uint32_t nanosPerCall = elapsedMicros * 1000 / NUM_ITERATIONS;
+
+  printName(name);
+  printMillisFraction(nanosPerCall);
+  Serial.print(F(" | "));
+#if defined(F_CPU)
+  uint32_t cyclesPerCall = nanosPerCall * (F_CPU / 1000000) / 1000;
+  char buf[8];
+  snprintf(buf, sizeof(buf), "%6lu", (unsigned long) cyclesPerCall);
+  Serial.print(buf);
+#else
+  Serial.print(F("     -"));
+#endif
+  Serial.println(F(" |"));
+}
+
+void runBenchmarks() {
+  emptyLoopMicros = timeLoop(emptyLoop);
+
+  printHeader();
+  runBenchmark(F("PatternWriter::writePattern()"), writePattern);
+  runBenchmark(F("PatternWriter::writePatterns()"), writePatterns);
+  runBenchmark(F("PatternWriter::clear()"), clear);
+  runBenchmark(F("toDecimal(), division"), toDecimalUsingDivision);
+  runBenchmark(F("toDecimal(), multiply and shift"), toDecimalUsingReciprocal);
+  runBenchmark(F("NumberWriter::writeUnsignedDecimal()"), writeUnsignedDecimal);
+  runBenchmark(F("writeUnsignedDecimal(), RamStorage"),
+      writeUnsignedDecimalRam);
+  runBenchmark(F("NumberWriter::writeSignedDecimal()"), writeSignedDecimal);
+  runBenchmark(F("CachedNumberWriter::writeSignedDecimal()"),
+      writeSignedDecimalCached);
+  runBenchmark(F("NumberWriter::writeDec2()"), writeDec2);
+  runBenchmark(F("NumberWriter::writeDec4()"), writeDec4);
+  runBenchmark(F("PrintStr<16>::print(float) + writeChar()"),
+      writeFloatUsingPrint);
+  runBenchmark(F("NumberWriter::writeFloat()"), writeFloat);
+  runBenchmark(F("NumberWriter::writeFloatExp()"), writeFloatExp);
+  runBenchmark(F("NumberWriter::writeFloatFit()"), writeFloatFit);
+  runBenchmark(F("ClockWriter::writeHourMinute24()"), writeHourMinute24);
+  incrementalClockWriter.setTime(0, 0, 0);
+  runBenchmark(F("IncrementalClockWriter::tick()"), tickIncrementalClock);
+  runBenchmark(F("NumberWriter::writeDec4(), counter"),
+      writeCounterUsingDivision);
+  counterWriter.setValue(0);
+  runBenchmark(F("CounterWriter::increment()"), incrementCounter);
+  runBenchmark(F("CounterWriter::decrement()"), decrementCounter);
+  runBenchmark(F("TemperatureWriter::writeTempDegC()"), writeTempDegC);
+  runBenchmark(F("CharWriter::writeChar()"), writeChar);
+  runBenchmark(F("CharWriter::writeChar(), RamStorage"), writeCharRam);
+  runBenchmark(F("StringWriter::writeString()"), writeString);
+  runBenchmark(F("LevelWriter::writeLevel()"), writeLevel);
+
+  initMarquee();
+  runBenchmark(F("StringScroller::scrollLeft()"), scrollLeft);
+  initMarqueeRight();
+  runBenchmark(F("StringScroller::scrollRight()"), scrollRight);
+  printFooter();
+}
+
+//-----------------------------------------------------------------------------
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // Wait for stability on some boards, otherwise garbage on Serial
+#endif
+
+  Serial.begin(115200); // ESP8266 default of 74880 not supported on Linux
+  while (!Serial); // Wait until Serial is ready - Leonardo/Micro
+
+  Serial.print(F("NUM_ITERATIONS="));
+  Serial.println(NUM_ITERATIONS);
+  runBenchmarks();
+
+#if defined(EPOXY_DUINO)
+  exit(0);
+#endif
+}
+
+void loop() {}
@@ -26,6 +26,33 @@ using namespace ace_segment;
 #define FEATURE_STRING_WRITER 7
 #define FEATURE_STRING_SCROLLER 8
 #define FEATURE_LEVEL_WRITER 9
+#define FEATURE_PATTERN_WRITER_FIXED_DIGITS 10
+#define FEATURE_NUMBER_WRITER_FIXED_DIGITS 11
+#define FEATURE_STRING_WRITER_FIXED_DIGITS 12
+#define FEATURE_STRING_SCROLLER_FIXED_DIGITS 13
+#define FEATURE_LEVEL_WRITER_FIXED_DIGITS 14
+#define FEATURE_NUMBER_WRITER_WRITE_DECIMAL32 15
+#define FEATURE_NUMBER_WRITER_WRITE_FIXED 16
+#define FEATURE_NUMBER_WRITER_PRINT_FLOAT 17
+#define FEATURE_NUMBER_WRITER_WRITE_FLOAT_FIT 18
+#define FEATURE_CONST_PATTERNS 19
+#define FEATURE_CHAINED_MODULE 20
+#define FEATURE_BROADCAST_MODULE 21
+#define FEATURE_FRAME_RECORDER_MODULE 22
+#define FEATURE_CHAR_WRITER_ASCII_FONT 23
+#define FEATURE_CHAR_WRITER_DIGIT_FONT 24
+#define FEATURE_CHAR_WRITER_SPARSE_FONT 25
+#define FEATURE_NUMBER_WRITER_RAM_STORAGE 26
+#define FEATURE_CHAR_WRITER_RAM_STORAGE 27
+#define FEATURE_ANIMATION_PLAYER 28
+#define FEATURE_COMPRESSED_ANIMATION_PLAYER 29
+#define FEATURE_INCREMENTAL_CLOCK_WRITER 30
+#define FEATURE_COUNTER_WRITER 31
+#define FEATURE_CACHED_NUMBER_WRITER 32
+#define FEATURE_NUMBER_FILTER 33
+#define FEATURE_TEMPERATURE_WRITER_TENTHS 34
+#define FEATURE_ANIMATION_PLAYER_8_DIGITS 35
+#define FEATURE_COMPRESSED_ANIMATION_PLAYER_8_DIGITS 36
 
 // A volatile integer to prevent the compiler from optimizing away the entire
 // program.
@@ -38,12 +65,15 @@ const uint8_t NUM_DIGITS = 4;
 // class, without inheriting from LedModule. The Writer classes are templatized,
 // so we can just use the StubModule. This means that this program does not
 // depend on the AceSegment library at all, and we can isolate the benchmarks to
-// just the Writer classes in this library.
+// just the Writer classes in this library. Like the LedModule, the number of
+// digits is stored in a member variable, so that the Writer classes with a
+// compile-time T_DIGITS (the FEATURE_XXX_FIXED_DIGITS) can be compared against
+// the ones which call size() at runtime.
 class StubModule {
   public:
-    StubModule() {}
+    StubModule() : mNumDigits(NUM_DIGITS) {}
 
-    uint8_t size() const { return NUM_DIGITS; }
+    uint8_t size() const { return mNumDigits; }
 
     void setPatternAt(uint8_t pos, uint8_t pattern) {
       mPatterns[pos] = pattern;
@@ -72,6 +102,7 @@ class StubModule {
 
   private:
     uint8_t mPatterns[NUM_DIGITS];
+    uint8_t mNumDigits;
     uint8_t mBrightness;
 };
 
@@ -126,6 +157,231 @@ class StubModule {
   PatternWriter<StubModule> patternWriter(stubModule);
   LevelWriter<StubModule> levelWriter(patternWriter);
 
+#elif FEATURE == FEATURE_PATTERN_WRITER_FIXED_DIGITS
+  StubModule stubModule;
+  PatternWriter<StubModule, NUM_DIGITS> patternWriter(stubModule);
+
+#elif FEATURE == FEATURE_NUMBER_WRITER_FIXED_DIGITS
+  StubModule stubModule;
+  PatternWriter<StubModule, NUM_DIGITS> patternWriter(stubModule);
+  NumberWriter<StubModule, NUM_DIGITS> numberWriter(patternWriter);
+
+#elif FEATURE == FEATURE_STRING_WRITER_FIXED_DIGITS
+  StubModule stubModule;
+  PatternWriter<StubModule, NUM_DIGITS> patternWriter(stubModule);
+  CharWriter<StubModule, NUM_DIGITS> charWriter(patternWriter);
+  StringWriter<StubModule, NUM_DIGITS> stringWriter(charWriter);
+
+#elif FEATURE == FEATURE_STRING_SCROLLER_FIXED_DIGITS
+  StubModule stubModule;
+  PatternWriter<StubModule, NUM_DIGITS> patternWriter(stubModule);
+  CharWriter<StubModule, NUM_DIGITS> charWriter(patternWriter);
+  StringScroller<StubModule, NUM_DIGITS> stringScroller(charWriter);
+
+#elif FEATURE == FEATURE_LEVEL_WRITER_FIXED_DIGITS
+  StubModule stubModule;
+  PatternWriter<StubModule, NUM_DIGITS> patternWriter(stubModule);
+  LevelWriter<StubModule, NUM_DIGITS> levelWriter(patternWriter);
+
+#elif FEATURE == FEATURE_NUMBER_WRITER_WRITE_DECIMAL32
+  StubModule stubModule;
+  PatternWriter<StubModule> patternWriter(stubModule);
+  NumberWriter<StubModule> numberWriter(patternWriter);
+
+#elif FEATURE == FEATURE_NUMBER_WRITER_WRITE_FIXED
+  StubModule stubModule;
+  PatternWriter<StubModule> patternWriter(stubModule);
+  NumberWriter<StubModule> numberWriter(patternWriter);
+
+#elif FEATURE == FEATURE_NUMBER_WRITER_PRINT_FLOAT
+  StubModule stubModule;
+  PatternWriter<StubModule> patternWriter(stubModule);
+  NumberWriter<StubModule> numberWriter(patternWriter);
+
+#elif FEATURE == FEATURE_NUMBER_WRITER_WRITE_FLOAT_FIT
+  StubModule stubModule;
+  PatternWriter<StubModule> patternWriter(stubModule);
+  NumberWriter<StubModule> numberWriter(patternWriter);
+
+#elif FEATURE == FEATURE_CONST_PATTERNS
+  StubModule stubModule;
+  PatternWriter<StubModule> patternWriter(stubModule);
+  ACE_SEGMENT_WRITER_CONST_PATTERNS(HelloLabel, "Hello");
+
+#elif FEATURE == FEATURE_CHAINED_MODULE
+  StubModule stubModule;
+  StubModule stubModule2;
+  typedef ChainedModule<StubModule, NUM_DIGITS, 2> StubChainedModule;
+  StubChainedModule chainedModule({&stubModule, &stubModule2});
+  PatternWriter<StubChainedModule> patternWriter(chainedModule);
+
+#elif FEATURE == FEATURE_BROADCAST_MODULE
+  StubModule stubModule;
+  StubModule stubModule2;
+  typedef BroadcastModule<StubModule, NUM_DIGITS, 2> StubBroadcastModule;
+  StubBroadcastModule broadcastModule({&stubModule, &stubModule2});
+  PatternWriter<StubBroadcastModule> patternWriter(broadcastModule);
+
+#elif FEATURE == FEATURE_FRAME_RECORDER_MODULE
+  StubModule stubModule;
+  typedef FrameRecorderModule<StubModule, NUM_DIGITS, 8> StubRecorderModule;
+  StubRecorderModule recorderModule(stubModule);
+  PatternWriter<StubRecorderModule> patternWriter(recorderModule);
+
+#elif FEATURE == FEATURE_CHAR_WRITER_ASCII_FONT
+  StubModule stubModule;
+  PatternWriter<StubModule> patternWriter(stubModule);
+  CharWriter<StubModule> charWriter(patternWriter, kCharPatterns);
+
+#elif FEATURE == FEATURE_CHAR_WRITER_DIGIT_FONT
+  StubModule stubModule;
+  PatternWriter<StubModule> patternWriter(stubModule);
+  const CharFont DIGIT_FONT = {kDigitPatterns, '0', 10};
+  CharWriter<StubModule> charWriter(patternWriter, DIGIT_FONT);
+
+#elif FEATURE == FEATURE_CHAR_WRITER_SPARSE_FONT
+  StubModule stubModule;
+  PatternWriter<StubModule> patternWriter(stubModule);
+  const uint8_t SYMBOL_PAIRS[] PROGMEM = {
+    '-', 0b01000000,
+    'C', 0b00111001,
+    'F', 0b01110001,
+    'o', 0b01100011,
+  };
+  const SparseCharFont SYMBOL_FONT = {SYMBOL_PAIRS, 4};
+  SparseCharWriter<StubModule> charWriter(patternWriter, SYMBOL_FONT);
+
+#elif FEATURE == FEATURE_NUMBER_WRITER_RAM_STORAGE
+  StubModule stubModule;
+  PatternWriter<StubModule> patternWriter(stubModule);
+  NumberWriter<StubModule, 0, RamStorage> numberWriter(patternWriter);
+
+#elif FEATURE == FEATURE_CHAR_WRITER_RAM_STORAGE
+  StubModule stubModule;
+  PatternWriter<StubModule> patternWriter(stubModule);
+  CharWriter<StubModule, 0, RamStorage> charWriter(patternWriter);
+
+#elif FEATURE == FEATURE_ANIMATION_PLAYER
+  StubModule stubModule;
+  PatternWriter<StubModule> patternWriter(stubModule);
+  AnimationPlayer<StubModule> animationPlayer(patternWriter);
+  const uint8_t SPIN_FRAMES[6][NUM_DIGITS] PROGMEM = {
+    { 0x03, 0x03, 0x03, 0x03 },
+    { 0x06, 0x06, 0x06, 0x06 },
+    { 0x0c, 0x0c, 0x0c, 0x0c },
+    { 0x18, 0x18, 0x18, 0x18 },
+    { 0x30, 0x30, 0x30, 0x30 },
+    { 0x21, 0x21, 0x21, 0x21 },
+  };
+  const Animation SPIN_ANIMATION = {
+    &SPIN_FRAMES[0][0], nullptr, 6, NUM_DIGITS, 100
+  };
+
+#elif FEATURE == FEATURE_COMPRESSED_ANIMATION_PLAYER
+  StubModule stubModule;
+  PatternWriter<StubModule> patternWriter(stubModule);
+  CompressedAnimationPlayer<StubModule> animationPlayer(patternWriter);
+  const uint8_t SPIN_DATA[] PROGMEM = {
+    repeatRun(0, NUM_DIGITS), 0x03, kRunFrameEnd,
+    repeatRun(0, NUM_DIGITS), 0x06, kRunFrameEnd,
+    repeatRun(0, NUM_DIGITS), 0x0c, kRunFrameEnd,
+    repeatRun(0, NUM_DIGITS), 0x18, kRunFrameEnd,
+    repeatRun(0, NUM_DIGITS), 0x30, kRunFrameEnd,
+    repeatRun(0, NUM_DIGITS), 0x21, kRunFrameEnd,
+    repeatRun(0, NUM_DIGITS), 0x03, kRunFrameEnd,
+  };
+  const CompressedAnimation SPIN_ANIMATION = {
+    SPIN_DATA, nullptr, 6, NUM_DIGITS, 100
+  };
+
+#elif FEATURE == FEATURE_INCREMENTAL_CLOCK_WRITER
+  StubModule stubModule;
+  PatternWriter<StubModule> patternWriter(stubModule);
+  NumberWriter<StubModule> numberWriter(patternWriter);
+  ClockWriter<StubModule> clockWriter(numberWriter);
+  IncrementalClockWriter<StubModule> incrementalClockWriter(clockWriter);
+
+#elif FEATURE == FEATURE_COUNTER_WRITER
+  StubModule stubModule;
+  PatternWriter<StubModule> patternWriter(stubModule);
+  NumberWriter<StubModule> numberWriter(patternWriter);
+  CounterWriter<StubModule> counterWriter(numberWriter, NUM_DIGITS);
+
+#elif FEATURE == FEATURE_CACHED_NUMBER_WRITER
+  StubModule stubModule;
+  PatternWriter<StubModule> patternWriter(stubModule);
+  NumberWriter<StubModule> numberWriter(patternWriter);
+  CachedNumberWriter<StubModule> cachedNumberWriter(numberWriter);
+
+#elif FEATURE == FEATURE_NUMBER_FILTER
+  StubModule stubModule;
+  PatternWriter<StubModule> patternWriter(stubModule);
+  NumberWriter<StubModule> numberWriter(patternWriter);
+  NumberFilter numberFilter(1, 1000);
+
+#elif FEATURE == FEATURE_TEMPERATURE_WRITER_TENTHS
+  StubModule stubModule;
+  PatternWriter<StubModule> patternWriter(stubModule);
+  NumberWriter<StubModule> numberWriter(patternWriter);
+  TemperatureWriter<StubModule> temperatureWriter(numberWriter);
+
+#elif FEATURE == FEATURE_ANIMATION_PLAYER_8_DIGITS
+  StubModule stubModule;
+  StubModule stubModule2;
+  typedef ChainedModule<StubModule, NUM_DIGITS, 2> StubChainedModule;
+  StubChainedModule chainedModule({&stubModule, &stubModule2});
+  PatternWriter<StubChainedModule> patternWriter(chainedModule);
+  AnimationPlayer<StubChainedModule> animationPlayer(patternWriter);
+  // A bar which scans back and forth across 8 digits.
+  const uint8_t SCAN_FRAMES[14][2 * NUM_DIGITS] PROGMEM = {
+    { 0x49, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x00, 0x49, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x00, 0x00, 0x49, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x00, 0x00, 0x00, 0x49, 0x00, 0x00, 0x00, 0x00 },
+    { 0x00, 0x00, 0x00, 0x00, 0x49, 0x00, 0x00, 0x00 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x49, 0x00, 0x00 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x49, 0x00 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x49 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x49, 0x00 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x49, 0x00, 0x00 },
+    { 0x00, 0x00, 0x00, 0x00, 0x49, 0x00, 0x00, 0x00 },
+    { 0x00, 0x00, 0x00, 0x49, 0x00, 0x00, 0x00, 0x00 },
+    { 0x00, 0x00, 0x49, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x00, 0x49, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+  };
+  const Animation SCAN_ANIMATION = {
+    &SCAN_FRAMES[0][0], nullptr, 14, 2 * NUM_DIGITS, 100
+  };
+
+#elif FEATURE == FEATURE_COMPRESSED_ANIMATION_PLAYER_8_DIGITS
+  StubModule stubModule;
+  StubModule stubModule2;
+  typedef ChainedModule<StubModule, NUM_DIGITS, 2> StubChainedModule;
+  StubChainedModule chainedModule({&stubModule, &stubModule2});
+  PatternWriter<StubChainedModule> patternWriter(chainedModule);
+  CompressedAnimationPlayer<StubChainedModule> animationPlayer(patternWriter);
+  // The same scanning bar, storing only the 2 digits which change per frame.
+  const uint8_t SCAN_DATA[] PROGMEM = {
+    literalRun(0, 1), 0x49, repeatRun(0, 7), 0x00, kRunFrameEnd,
+    literalRun(0, 2), 0x00, 0x49, kRunFrameEnd,
+    literalRun(1, 2), 0x00, 0x49, kRunFrameEnd,
+    literalRun(2, 2), 0x00, 0x49, kRunFrameEnd,
+    literalRun(3, 2), 0x00, 0x49, kRunFrameEnd,
+    literalRun(4, 2), 0x00, 0x49, kRunFrameEnd,
+    literalRun(5, 2), 0x00, 0x49, kRunFrameEnd,
+    literalRun(6, 2), 0x00, 0x49, kRunFrameEnd,
+    literalRun(6, 2), 0x49, 0x00, kRunFrameEnd,
+    literalRun(5, 2), 0x49, 0x00, kRunFrameEnd,
+    literalRun(4, 2), 0x49, 0x00, kRunFrameEnd,
+    literalRun(3, 2), 0x49, 0x00, kRunFrameEnd,
+    literalRun(2, 2), 0x49, 0x00, kRunFrameEnd,
+    literalRun(1, 2), 0x49, 0x00, kRunFrameEnd,
+    literalRun(0, 2), 0x49, 0x00, kRunFrameEnd,
+  };
+  const CompressedAnimation SCAN_ANIMATION = {
+    SCAN_DATA, nullptr, 14, 2 * NUM_DIGITS, 100
+  };
+
 #else
   #error Unknown FEATURE
 
@@ -194,6 +450,117 @@ void loop() {
 #elif FEATURE == FEATURE_LEVEL_WRITER
   levelWriter.writeLevel(disableCompilerOptimization);
 
+#elif FEATURE == FEATURE_PATTERN_WRITER_FIXED_DIGITS
+  patternWriter.writePattern(disableCompilerOptimization);
+
+#elif FEATURE == FEATURE_NUMBER_WRITER_FIXED_DIGITS
+  numberWriter.writeUnsignedDecimal(disableCompilerOptimization);
+
+#elif FEATURE == FEATURE_STRING_WRITER_FIXED_DIGITS
+  stringWriter.writeString(F("Hello"));
+
+#elif FEATURE == FEATURE_STRING_SCROLLER_FIXED_DIGITS
+  stringScroller.initScrollLeft(F("Hello"));
+  stringScroller.scrollLeft();
+
+#elif FEATURE == FEATURE_LEVEL_WRITER_FIXED_DIGITS
+  levelWriter.writeLevel(disableCompilerOptimization);
+
+#elif FEATURE == FEATURE_NUMBER_WRITER_WRITE_DECIMAL32
+  numberWriter.writeSignedDecimal32((int32_t) disableCompilerOptimization
+      * 100000);
+
+#elif FEATURE == FEATURE_NUMBER_WRITER_WRITE_FIXED
+  numberWriter.writeFixed((int32_t) disableCompilerOptimization * 100000, 2);
+
+#elif FEATURE == FEATURE_NUMBER_WRITER_PRINT_FLOAT
+  // The implementation of NumberWriter::writeFloat() before v0.6, which
+  // formatted the float using the Print class.
+  {
+    ace_common::PrintStr<16> buf;
+    buf.print((float) disableCompilerOptimization, 2);
+    for (const char *s = buf.cstr(); *s != '\0'; s++) {
+      numberWriter.writeChar(*s);
+    }
+  }
+
+#elif FEATURE == FEATURE_NUMBER_WRITER_WRITE_FLOAT_FIT
+  numberWriter.writeFloatFit((float) disableCompilerOptimization, 4);
+
+#elif FEATURE == FEATURE_CONST_PATTERNS
+  patternWriter.writePatterns_P(HelloLabel::kPatterns, HelloLabel::kLength);
+
+#elif FEATURE == FEATURE_CHAINED_MODULE
+  patternWriter.home();
+  patternWriter.writeRepeatedPattern(0xff, 2 * NUM_DIGITS);
+
+#elif FEATURE == FEATURE_BROADCAST_MODULE
+  patternWriter.home();
+  patternWriter.writeRepeatedPattern(0xff, NUM_DIGITS);
+
+#elif FEATURE == FEATURE_FRAME_RECORDER_MODULE
+  patternWriter.home();
+  patternWriter.writePattern(0xff);
+  recorderModule.commit(millis());
+  if (disableCompilerOptimization) recorderModule.dump(Serial);
+
+#elif FEATURE == FEATURE_CHAR_WRITER_ASCII_FONT
+  charWriter.writeChar(disableCompilerOptimization);
+
+#elif FEATURE == FEATURE_CHAR_WRITER_DIGIT_FONT
+  charWriter.writeChar(disableCompilerOptimization);
+
+#elif FEATURE == FEATURE_CHAR_WRITER_SPARSE_FONT
+  charWriter.writeChar(disableCompilerOptimization);
+
+#elif FEATURE == FEATURE_NUMBER_WRITER_RAM_STORAGE
+  numberWriter.writeUnsignedDecimal(disableCompilerOptimization);
+
+#elif FEATURE == FEATURE_CHAR_WRITER_RAM_STORAGE
+  charWriter.writeChar(disableCompilerOptimization);
+
+#elif FEATURE == FEATURE_ANIMATION_PLAYER
+  if (disableCompilerOptimization) animationPlayer.play(SPIN_ANIMATION);
+  animationPlayer.tick(millis());
+
+#elif FEATURE == FEATURE_COMPRESSED_ANIMATION_PLAYER
+  if (disableCompilerOptimization) animationPlayer.play(SPIN_ANIMATION);
+  animationPlayer.tick(millis());
+
+#elif FEATURE == FEATURE_INCREMENTAL_CLOCK_WRITER
+  if (disableCompilerOptimization) incrementalClockWriter.setTime(10, 0, 0);
+  incrementalClockWriter.tick();
+
+#elif FEATURE == FEATURE_COUNTER_WRITER
+  if (disableCompilerOptimization) {
+    counterWriter.decrement();
+  } else {
+    counterWriter.increment();
+  }
+
+#elif FEATURE == FEATURE_CACHED_NUMBER_WRITER
+  numberWriter.home();
+  cachedNumberWriter.writeUnsignedDecimal(disableCompilerOptimization);
+
+#elif FEATURE == FEATURE_NUMBER_FILTER
+  if (numberFilter.update(disableCompilerOptimization, millis())) {
+    numberWriter.home();
+    numberWriter.writeUnsignedDecimal(numberFilter.value());
+  }
+
+#elif FEATURE == FEATURE_TEMPERATURE_WRITER_TENTHS
+  temperatureWriter.writeTempTenthsDegF(
+      celsiusToFahrenheitTenths(disableCompilerOptimization) /*tenths*/,
+      4 /*boxSize*/);
+
+#elif FEATURE == FEATURE_ANIMATION_PLAYER_8_DIGITS
+  if (disableCompilerOptimization) animationPlayer.play(SCAN_ANIMATION);
+  animationPlayer.tick(millis());
+
+#elif FEATURE == FEATURE_COMPRESSED_ANIMATION_PLAYER_8_DIGITS
+  if (disableCompilerOptimization) animationPlayer.play(SCAN_ANIMATION);
+  animationPlayer.tick(millis());
+
 #else
   #error Unknown FEATURE
 #endif
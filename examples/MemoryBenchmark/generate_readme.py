@@ -85,6 +85,58 @@ $ make README.md
 
 * Initial MemoryBenchmark after extracting from AceSegment v0.8.2.
 
+**Unreleased**
+
+* `StubModule::size()` returns a member variable, like `LedModule`, instead of
+  a compile-time constant.
+* Add `PatternWriter<4>`, `NumberWriter<4>`, `StringWriter<4>`,
+  `StringScroller<4>`, and `LevelWriter<4>` which use a compile-time `T_DIGITS`
+  template parameter.
+* Add `NumberWriter::writeDecimal32()` and `NumberWriter::writeFixed()` which
+  write 32-bit integers and fixed-point numbers using integer arithmetic.
+  Compare them against `NumberWriter::writeFloat()`.
+* `NumberWriter::writeFloat()` no longer uses the `Print` class. Add
+  `PrintStr::print(float)` which measures the previous implementation, and
+  `NumberWriter::writeFloatFit()`.
+* Add `ConstPatterns` which writes the compile-time rendering of the same
+  "Hello" string as `StringWriter`, without the `kCharPatterns` font.
+* `StringScroller` keeps a ring buffer of 16 patterns, or `T_DIGITS` patterns
+  for `StringScroller<4>`, in static RAM.
+* Add `ChainedModule<2>` which drives a `PatternWriter` spanning two
+  `StubModule` instances.
+* Add `BroadcastModule<2>` which mirrors a `PatternWriter` onto two
+  `StubModule` instances.
+* Add `FrameRecorderModule<4,8>` which records the last 8 frames of a 4-digit
+  `StubModule`, including the code of `dump()`.
+* `CharWriter` uses the 95-character `kCharFont` by default instead of the
+  128-character `kCharPatterns`, whose table is 33 bytes larger. Add
+  `CharWriter(kCharPatterns)` to measure the previous font,
+  `CharWriter(digits font)` which reuses `kDigitPatterns` for the characters
+  `0` to `9`, and `SparseCharWriter` which uses a `SparseCharFont` of 4
+  symbols.
+* Add `NumberWriter<RamStorage>` and `CharWriter<RamStorage>` which read the
+  digit patterns and the font from RAM instead of flash.
+* Add `AnimationPlayer`, which plays the 6-frame spin animation of
+  `WriterTester` from PROGMEM.
+* Add `CompressedAnimationPlayer`, which plays the same animation encoded as
+  differences between frames. Every digit of the spin changes in every frame,
+  so the compressed table is barely smaller, and the decoder adds code.
+* Add `AnimationPlayer, 8 digits` and `CompressedAnimationPlayer, 8 digits`,
+  which play a bar scanning across 8 digits of a `ChainedModule` in 14 frames.
+  Only 2 digits change per frame, so the table shrinks from 112 to 61 bytes.
+  Compare the difference in flash with the code size of the decoder.
+* Add `IncrementalClockWriter`, which rewrites only the clock digits which
+  changed.
+* Add `CounterWriter`, a 4-digit counter which is incremented and
+  decremented.
+* Add `CachedNumberWriter`, which skips `writeUnsignedDecimal()` if the
+  value has not changed. Compare with `NumberWriter`.
+* Add `NumberFilter` in front of `NumberWriter`, which writes a noisy
+  reading only when it changes beyond a deadband.
+* Add `TemperatureWriter::writeTempTenthsDegF()` with
+  `celsiusToFahrenheitTenths()`, which writes a fractional temperature using
+  integer arithmetic. Compare with `NumberWriter::writeFloat()`.
+
 ## Results
 
 The following shows the flash and static memory sizes of the `MemoryBenchmark`
@@ -97,6 +149,14 @@ program for various Writer classes.
 * `StringWriter`
 * `StringScroller`
 * `LevelWriter`
+* `XxxWriter<4>`
+    * The same Writer classes with the number of digits given as the
+      compile-time `T_DIGITS` template parameter, instead of being retrieved
+      from `T_LED_MODULE::size()` at runtime.
+
+The tables below have not been regenerated since v0.1, so they do not contain
+the rows added in the **Unreleased** section above. Those rows will appear the
+next time `collect.sh` and `generate_readme.py` are run on the build machine.
 
 ### ATtiny85
 
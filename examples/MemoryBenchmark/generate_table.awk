@@ -16,6 +16,33 @@ BEGIN {
   labels[7] = "StringWriter";
   labels[8] = "StringScroller";
   labels[9] = "LevelWriter";
+  labels[10] = "PatternWriter<4>";
+  labels[11] = "NumberWriter<4>";
+  labels[12] = "StringWriter<4>";
+  labels[13] = "StringScroller<4>";
+  labels[14] = "LevelWriter<4>";
+  labels[15] = "NumberWriter::writeDecimal32()";
+  labels[16] = "NumberWriter::writeFixed()";
+  labels[17] = "PrintStr::print(float)";
+  labels[18] = "NumberWriter::writeFloatFit()";
+  labels[19] = "ConstPatterns";
+  labels[20] = "ChainedModule<2>";
+  labels[21] = "BroadcastModule<2>";
+  labels[22] = "FrameRecorderModule<4,8>";
+  labels[23] = "CharWriter(kCharPatterns)";
+  labels[24] = "CharWriter(digits font)";
+  labels[25] = "SparseCharWriter";
+  labels[26] = "NumberWriter<RamStorage>";
+  labels[27] = "CharWriter<RamStorage>";
+  labels[28] = "AnimationPlayer";
+  labels[29] = "CompressedAnimationPlayer";
+  labels[30] = "IncrementalClockWriter";
+  labels[31] = "CounterWriter";
+  labels[32] = "CachedNumberWriter";
+  labels[33] = "NumberFilter";
+  labels[34] = "TemperatureWriter, tenths";
+  labels[35] = "AnimationPlayer, 8 digits";
+  labels[36] = "CompressedAnimationPlayer, 8 digits";
   record_index = 0
 }
 {
@@ -47,7 +74,8 @@ END {
     name = labels[i]
 
     if (name ~ /^baseline/ \
-        || name ~ /^PatternWriter/) {
+        || name ~ /^PatternWriter$/ \
+        || name ~ /^PatternWriter<4>/) {
       printf(\
         "|---------------------------------+--------------+-------------|\n")
     }
@@ -36,8 +36,12 @@ static const char SCROLL_STRING[] PROGMEM =
 "the quick brown fox jumps over the lazy dog, "
 "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG. ";
 
-// Scroll left. Then scroll right.
-void scrollString() {
+const uint16_t SCROLL_PERIOD = 300;
+
+// Scroll left. Then scroll right. The StringScroller::tick() method takes the
+// scroll steps which are due according to SCROLL_PERIOD, and writes nothing to
+// the LED module if no step is due, so the module is flushed only when needed.
+void scrollLoop() {
   static bool isInit = false;
   static bool scrollLeft = true;
 
@@ -52,32 +56,16 @@ void scrollString() {
     isInit = true;
   }
 
-  bool isDone;
-  if (scrollLeft) {
-    isDone = stringScroller.scrollLeft();
-  } else {
-    isDone = stringScroller.scrollRight();
+  if (stringScroller.tick(millis()) > 0) {
+    ledModule.flush();
   }
 
-  if (isDone) {
+  if (stringScroller.isDone()) {
     scrollLeft = !scrollLeft;
     isInit = false;
   }
 }
 
-const uint16_t SCROLL_DELAY = 300;
-
-void scrollLoop() {
-  static uint16_t lastUpdateMillis = millis();
-
-  uint16_t nowMillis = millis();
-  if ((uint16_t) (nowMillis - lastUpdateMillis) >= SCROLL_DELAY) {
-    lastUpdateMillis = nowMillis;
-    scrollString();
-    ledModule.flush();
-  }
-}
-
 void setup() {
   delay(1000);
 
@@ -85,6 +73,7 @@ void setup() {
   ledModule.begin();
 
   ledModule.setBrightness(2);
+  stringScroller.setFramePeriod(SCROLL_PERIOD);
 
   ledModule.flush();
 }
@@ -86,6 +86,12 @@ using ace_segment::TemperatureWriter;
 using ace_segment::StringWriter;
 using ace_segment::StringScroller;
 using ace_segment::LevelWriter;
+using ace_segment::FrameBufferModule;
+using ace_segment::ProfilingModule;
+using ace_segment::ProfilingStats;
+using ace_segment::FrameTicker;
+using ace_segment::AnimationPlayer;
+using ace_segment::Animation;
 using ace_segment::kDigitRemapArray8Max7219;
 using ace_segment::kDigitRemapArray8Hc595;
 using ace_segment::kByteOrderSegmentHighDigitLow;
@@ -100,6 +106,12 @@ using ace_segment::kActiveHighPattern;
 // Use polling or interrupt.
 #define USE_INTERRUPT 0
 
+// Wrap the LED module in a ProfilingModule and print the module traffic
+// generated by each frame of the demo on the Serial port.
+#ifndef USE_PROFILING
+#define USE_PROFILING 0
+#endif
+
 #if USE_INTERRUPT
   #include <TimerOne.h>
 #endif
@@ -863,14 +875,36 @@ const uint8_t NUM_SUBFIELDS = 1;
   #error Unknown LED_DISPLAY_TYPE
 #endif
 
-PatternWriter<LedModule> patternWriter(ledModule);
-NumberWriter<LedModule> numberWriter(patternWriter);
-ClockWriter<LedModule> clockWriter(numberWriter);
-TemperatureWriter<LedModule> temperatureWriter(numberWriter);
-CharWriter<LedModule> charWriter(patternWriter);
-StringWriter<LedModule> stringWriter(charWriter);
-StringScroller<LedModule> stringScroller(charWriter);
-LevelWriter<LedModule> levelWriter(patternWriter);
+#if USE_INTERRUPT
+  // The writers compose each frame in the back buffer, and the Timer1 ISR
+  // publishes only complete frames to the ledModule.
+  FrameBufferModule<LedModule, NUM_DIGITS> frameBufferModule(ledModule);
+  typedef FrameBufferModule<LedModule, NUM_DIGITS> BaseModule;
+  BaseModule& baseModule = frameBufferModule;
+#else
+  typedef LedModule BaseModule;
+  BaseModule& baseModule = ledModule;
+#endif
+
+#if USE_PROFILING
+  // Count the calls made by the writers to the module.
+  ProfilingModule<BaseModule> profilingModule(baseModule);
+  typedef ProfilingModule<BaseModule> WriterModule;
+  WriterModule& writerModule = profilingModule;
+#else
+  typedef BaseModule WriterModule;
+  WriterModule& writerModule = baseModule;
+#endif
+
+PatternWriter<WriterModule> patternWriter(writerModule);
+NumberWriter<WriterModule> numberWriter(patternWriter);
+ClockWriter<WriterModule> clockWriter(numberWriter);
+TemperatureWriter<WriterModule> temperatureWriter(numberWriter);
+CharWriter<WriterModule> charWriter(patternWriter);
+StringWriter<WriterModule> stringWriter(charWriter);
+StringScroller<WriterModule> stringScroller(charWriter);
+LevelWriter<WriterModule> levelWriter(patternWriter);
+AnimationPlayer<WriterModule> animationPlayer(patternWriter);
 
 // Setup the various resources.
 void setupAceSegment() {
@@ -924,6 +958,7 @@ void setupAceSegment() {
 
 #if USE_INTERRUPT == 1
 void renderNow() {
+  frameBufferModule.publish();
   ledModule.renderFieldNow();
 }
 
@@ -970,14 +1005,48 @@ static const uint16_t DEMO_INTERNAL_DELAY[DEMO_MODE_COUNT] = {
   200, // DEMO_MODE_CHAR
   500, // DEMO_MODE_STRINGS
   300, // DEMO_MODE_SCROLL
-  100, // DEMO_MODE_SPIN
-  100, // DEMO_MODE_SPIN2
+  100, // DEMO_MODE_SPIN, unused, see SPIN_ANIMATION
+  100, // DEMO_MODE_SPIN2, unused, see SPIN_ANIMATION_2
   200, // DEMO_MODE_LEVEL
 };
 
 
 //-----------------------------------------------------------------------------
 
+#if USE_PROFILING
+/**
+ * Print the module traffic of the frame which was just written, in the format
+ * "demo=8 set=0 setN=2 n=4 redundant=3 dp=0/0 bright=0 pos=0-3".
+ */
+void printProfile() {
+  ProfilingStats stats = profilingModule.snapshot();
+  Serial.print(F("demo="));
+  Serial.print(demoMode);
+  Serial.print(F(" set="));
+  Serial.print(stats.numSetPatternAt);
+  Serial.print(F(" setN="));
+  Serial.print(stats.numSetPatternsAt);
+  Serial.print(F(" n="));
+  Serial.print(stats.numPatterns);
+  Serial.print(F(" redundant="));
+  Serial.print(stats.numRedundantPatterns);
+  Serial.print(F(" dp="));
+  Serial.print(stats.numSetDecimalPointAt);
+  Serial.print('/');
+  Serial.print(stats.numRedundantDecimalPoints);
+  Serial.print(F(" bright="));
+  Serial.print(stats.numSetBrightness);
+  Serial.print(F(" pos="));
+  if (stats.hasWrites()) {
+    Serial.print(stats.minPos);
+    Serial.print('-');
+    Serial.println(stats.maxPos);
+  } else {
+    Serial.println('-');
+  }
+}
+#endif
+
 void writeHexNumbers() {
   static uint16_t w = 0;
 
@@ -1047,7 +1116,8 @@ void writeClock() {
 //-----------------------------------------------------------------------------
 
 void writeChars() {
-  static uint8_t b = 0;
+  static uint8_t index = 0;
+  uint8_t b = charWriter.getFirstChar() + index;
 
   numberWriter.home();
   numberWriter.writeHexByte(b);
@@ -1056,9 +1126,9 @@ void writeChars() {
 
   uint8_t numChars = charWriter.getNumChars();
   if (numChars == 0) { // 0 means 256
-    b++;
+    index++;
   } else {
-    incrementMod(b, numChars);
+    incrementMod(index, numChars);
   }
 }
 
@@ -1094,7 +1164,7 @@ static const char SCROLL_STRING[] PROGMEM =
 "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG. "
 "[0123456789]";
 
-void scrollString() {
+void scrollString(uint16_t numFrames) {
   static bool isInit = false;
   static bool scrollLeft = true;
 
@@ -1111,9 +1181,9 @@ void scrollString() {
 
   bool isDone;
   if (scrollLeft) {
-    isDone = stringScroller.scrollLeft();
+    isDone = stringScroller.scrollLeft(numFrames);
   } else {
-    isDone = stringScroller.scrollRight();
+    isDone = stringScroller.scrollRight(numFrames);
   }
 
   if (isDone) {
@@ -1132,14 +1202,10 @@ const uint8_t SPIN_PATTERNS[NUM_SPIN_PATTERNS][4] PROGMEM = {
   { 0x09, 0x00, 0x00, 0x09 },  // Frame 2
 };
 
-void spinDisplay() {
-  static uint8_t i = 0;
-  const uint8_t* patterns = SPIN_PATTERNS[i];
-  patternWriter.home();
-  patternWriter.writePatterns_P(patterns, 4);
-
-  incrementMod(i, NUM_SPIN_PATTERNS);
-}
+const Animation SPIN_ANIMATION = {
+  &SPIN_PATTERNS[0][0], nullptr /*durations*/, NUM_SPIN_PATTERNS, 4,
+  100 /*framePeriodMillis*/
+};
 
 //-----------------------------------------------------------------------------
 
@@ -1154,13 +1220,31 @@ const uint8_t SPIN_PATTERNS_2[NUM_SPIN_PATTERNS_2][4] PROGMEM = {
   { 0x21, 0x21, 0x21, 0x21 },  // Frame 5
 };
 
-void spinDisplay2() {
-  static uint8_t i = 0;
-  const uint8_t* patterns = SPIN_PATTERNS_2[i];
-  patternWriter.home();
-  patternWriter.writePatterns_P(patterns, 4 /*len*/);
+const Animation SPIN_ANIMATION_2 = {
+  &SPIN_PATTERNS_2[0][0], nullptr /*durations*/, NUM_SPIN_PATTERNS_2, 4,
+  100 /*framePeriodMillis*/
+};
+
+/** Return true if the current demo is played by the animationPlayer. */
+bool isAnimationDemo() {
+  return demoMode == DEMO_MODE_SPIN || demoMode == DEMO_MODE_SPIN_2;
+}
 
-  incrementMod(i, NUM_SPIN_PATTERNS_2);
+/** Start the animation of the current demo. */
+void playAnimation() {
+  if (demoMode == DEMO_MODE_SPIN) {
+    animationPlayer.play(SPIN_ANIMATION);
+  } else if (demoMode == DEMO_MODE_SPIN_2) {
+    animationPlayer.play(SPIN_ANIMATION_2);
+  }
+}
+
+/**
+ * Display the frame of the animation which is due now. Only the digits which
+ * changed since the previous frame are written.
+ */
+bool spinDisplay() {
+  return animationPlayer.tick(millis());
 }
 
 //-----------------------------------------------------------------------------
@@ -1183,8 +1267,24 @@ void writeLevels() {
 
 //-----------------------------------------------------------------------------
 
-/** Display the demo pattern selected by demoMode. */
-void updateDemo() {
+/** Publish the frame written by the demo. */
+void commitDemo() {
+#if USE_INTERRUPT
+  frameBufferModule.commit();
+#endif
+
+#if USE_PROFILING
+  printProfile();
+#endif
+}
+
+/**
+ * Display the demo pattern selected by demoMode. The scroll animation skips
+ * the intermediate frames if `numFrames` is greater than 1. The spin
+ * animations advance by exactly one frame, so that a paused demo can be
+ * single-stepped. In the auto loop, they are timed by spinDisplay() instead.
+ */
+void updateDemo(uint16_t numFrames) {
   if (demoMode == DEMO_MODE_HEX_NUMBERS) {
     writeHexNumbers();
   } else if (demoMode == DEMO_MODE_CLOCK) {
@@ -1202,14 +1302,14 @@ void updateDemo() {
   } else if (demoMode == DEMO_MODE_STRINGS) {
     writeStrings();
   } else if (demoMode == DEMO_MODE_SCROLL) {
-    scrollString();
-  } else if (demoMode == DEMO_MODE_SPIN) {
-    spinDisplay();
-  } else if (demoMode == DEMO_MODE_SPIN_2) {
-    spinDisplay2();
+    scrollString(numFrames);
+  } else if (isAnimationDemo()) {
+    animationPlayer.nextFrame(millis());
   } else if (demoMode == DEMO_MODE_LEVEL) {
     writeLevels();
   }
+
+  commitDemo();
 }
 
 /** Go to the next demo. */
@@ -1232,21 +1332,33 @@ void nextDemo() {
 #endif
 
   patternWriter.clear();
+  playAnimation();
 
-  updateDemo();
+  updateDemo(1 /*numFrames*/);
 }
 
-/** Loop within a single demo. */
+FrameTicker demoTicker;
+
+/**
+ * Loop within a single demo. Nothing is written to the LED module until the
+ * next frame of the demo is due.
+ */
 void demoLoop() {
-  static uint16_t lastUpdateMillis = millis();
+  // A paused demo advances only by single-stepping.
+  if (demoLoopMode != DEMO_LOOP_MODE_AUTO) return;
 
-  uint16_t demoInternalDelay = DEMO_INTERNAL_DELAY[demoMode];
-  uint16_t nowMillis = millis();
-  if ((uint16_t) (nowMillis - lastUpdateMillis) >= demoInternalDelay) {
-    lastUpdateMillis = nowMillis;
-    if (demoLoopMode == DEMO_LOOP_MODE_AUTO) {
-      updateDemo();
+  // The spin demos are timed by the AnimationPlayer, frame by frame.
+  if (isAnimationDemo()) {
+    if (spinDisplay()) {
+      commitDemo();
     }
+    return;
+  }
+
+  demoTicker.setFramePeriod(DEMO_INTERNAL_DELAY[demoMode]);
+  uint16_t numFrames = demoTicker.tick(millis());
+  if (numFrames > 0) {
+    updateDemo(numFrames);
   }
 }
 
@@ -1324,7 +1436,7 @@ void handleEvent(AceButton* button, uint8_t eventType, uint8_t buttonState) {
           if (ENABLE_SERIAL_DEBUG >= 1) {
             Serial.println(F("handleEvent(): demo stepped"));
           }
-          updateDemo();
+          updateDemo(1 /*numFrames*/);
         }
         break;
 
@@ -1417,9 +1529,11 @@ void setup() {
   delay(1000); // Wait for stability on some boards, otherwise garage on Serial
 #endif
 
-  if (ENABLE_SERIAL_DEBUG >= 1) {
+  if (ENABLE_SERIAL_DEBUG >= 1 || USE_PROFILING) {
     Serial.begin(115200); // ESP8266 default of 74880 not supported on Linux
     while (!Serial); // Wait until Serial is ready - Leonardo/Micro
+  }
+  if (ENABLE_SERIAL_DEBUG >= 1) {
     Serial.println(F("setup(): begin"));
   }
 
@@ -1433,7 +1547,7 @@ void setup() {
     Serial.println(F("setup(): end"));
   }
 
-  updateDemo();
+  updateDemo(1 /*numFrames*/);
 }
 
 void loop() {
@@ -1443,9 +1557,7 @@ void loop() {
   }
 #endif
 
-  if (demoLoopMode == DEMO_LOOP_MODE_AUTO) {
-    demoLoop();
-  }
+  demoLoop();
 
   checkButtons();
 }
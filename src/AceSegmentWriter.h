@@ -47,12 +47,29 @@ SOFTWARE.
 #define ACE_SEGMENT_WRITER_VERSION_STRING "0.5.0"
 
 #include "ace_segment_writer/PatternWriter.h"
+#include "ace_segment_writer/PatternStorage.h"
 #include "ace_segment_writer/NumberWriter.h"
 #include "ace_segment_writer/ClockWriter.h"
+#include "ace_segment_writer/IncrementalClockWriter.h"
+#include "ace_segment_writer/CounterWriter.h"
+#include "ace_segment_writer/CachedNumberWriter.h"
 #include "ace_segment_writer/TemperatureWriter.h"
+#include "ace_segment_writer/CachedTemperatureWriter.h"
+#include "ace_segment_writer/NumberFilter.h"
 #include "ace_segment_writer/CharWriter.h"
+#include "ace_segment_writer/SparseCharWriter.h"
 #include "ace_segment_writer/StringWriter.h"
+#include "ace_segment_writer/ConstPatterns.h"
+#include "ace_segment_writer/FrameTicker.h"
 #include "ace_segment_writer/StringScroller.h"
 #include "ace_segment_writer/LevelWriter.h"
+#include "ace_segment_writer/AnimationPlayer.h"
+#include "ace_segment_writer/CompressedAnimation.h"
+#include "ace_segment_writer/ShadowModule.h"
+#include "ace_segment_writer/FrameBufferModule.h"
+#include "ace_segment_writer/ChainedModule.h"
+#include "ace_segment_writer/BroadcastModule.h"
+#include "ace_segment_writer/ProfilingModule.h"
+#include "ace_segment_writer/FrameRecorderModule.h"
 
 #endif
@@ -0,0 +1,303 @@
+/*
+MIT License
+
+Copyright (c) 2023 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_SEGMENT_WRITER_ANIMATION_PLAYER_H
+#define ACE_SEGMENT_WRITER_ANIMATION_PLAYER_H
+
+#include <stdint.h>
+#include <Arduino.h> // pgm_read_byte(), pgm_read_word()
+#include "PatternWriter.h"
+
+namespace ace_segment {
+
+/**
+ * A sequence of frames played by the AnimationPlayer. Each frame consists of
+ * `numDigits` segment patterns, and the frames are stored consecutively in
+ * PROGMEM, usually as a 2-dimensional array `uint8_t [numFrames][numDigits]`.
+ *
+ * @code{.cpp}
+ * const uint8_t SPIN_FRAMES[3][4] PROGMEM = {
+ *   { 0x10, 0x01, 0x08, 0x02 },
+ *   { 0x20, 0x08, 0x01, 0x04 },
+ *   { 0x09, 0x00, 0x00, 0x09 },
+ * };
+ * const uint16_t SPIN_DURATIONS[3] PROGMEM = {100, 100, 300};
+ * const Animation SPIN_ANIMATION = {
+ *   &SPIN_FRAMES[0][0], // frames
+ *   SPIN_DURATIONS, // durations
+ *   3, // numFrames
+ *   4, // numDigits
+ *   0, // framePeriodMillis, unused
+ * };
+ * @endcode
+ */
+struct Animation {
+  /** Array of `numFrames * numDigits` segment patterns in PROGMEM. */
+  const uint8_t* frames;
+
+  /**
+   * Array of `numFrames` durations in milliseconds in PROGMEM, or nullptr if
+   * every frame lasts `framePeriodMillis`.
+   */
+  const uint16_t* durations;
+
+  /** Number of frames. */
+  uint8_t numFrames;
+
+  /** Number of digits in each frame. */
+  uint8_t numDigits;
+
+  /** Duration of every frame if `durations` is nullptr. */
+  uint16_t framePeriodMillis;
+};
+
+/**
+ * Play an Animation stored in PROGMEM on the LED module, without blocking.
+ * The application calls `tick()` with the current `millis()` as often as
+ * possible. The player advances to the frame which is due, skipping frames if
+ * `tick()` was called late, and writes to the LED module only the digits which
+ * differ from the previously displayed frame. Each run of changed digits is
+ * written with a single `PatternWriter::writePatterns_P()`.
+ *
+ * @code{.cpp}
+ * AnimationPlayer<LedModule> animationPlayer(patternWriter);
+ *
+ * void setup() {
+ *   ...
+ *   animationPlayer.play(SPIN_ANIMATION);
+ * }
+ *
+ * void loop() {
+ *   if (animationPlayer.tick(millis())) {
+ *     ledModule.flush();
+ *   }
+ * }
+ * @endcode
+ *
+ * The delta writes assume that nothing else writes to the digits of the
+ * animation while it is playing. If something does, call `invalidate()` to
+ * redraw the whole frame at the next `tick()`.
+ *
+ * @tparam T_LED_MODULE the class of the underlying LED Module, often LedModule
+ *    but other classes with the same generic public methods can be substituted
+ * @tparam T_DIGITS number of digits of the LED module if known at compile
+ *    time, which allows the bounds checks and loops to be optimized by the
+ *    compiler; or 0 (default) to use `T_LED_MODULE::size()` at runtime
+ */
+template <typename T_LED_MODULE, uint8_t T_DIGITS = 0>
+class AnimationPlayer {
+  public:
+    /** Constructor. */
+    explicit AnimationPlayer(
+        PatternWriter<T_LED_MODULE, T_DIGITS>& patternWriter) :
+        mPatternWriter(patternWriter),
+        mAnimation(),
+        mFrameStartMillis(0),
+        mFrame(0),
+        mDrawnFrame(kNoFrame),
+        mIsLoop(false),
+        mIsStarted(false),
+        mIsDone(true)
+    {}
+
+    /** Get the underlying LedModule. */
+    T_LED_MODULE& ledModule() { return mPatternWriter.ledModule(); }
+
+    /** Get the underlying PatternWriter. */
+    PatternWriter<T_LED_MODULE, T_DIGITS>& patternWriter() {
+      return mPatternWriter;
+    }
+
+    /**
+     * Start playing the `animation` from its first frame, which is written by
+     * the next call to `tick()`.
+     *
+     * @param animation the frames to play, copied into the player
+     * @param loop if true (default), restart from the first frame after the
+     *    last frame; if false, stop and keep the last frame on the display
+     */
+    void play(const Animation& animation, bool loop = true) {
+      mAnimation = animation;
+      mIsLoop = loop;
+      mIsStarted = false;
+      mIsDone = (animation.numFrames == 0);
+      mFrame = 0;
+      mDrawnFrame = kNoFrame;
+    }
+
+    /** Stop the animation, leaving the current frame on the display. */
+    void stop() { mIsDone = true; }
+
+    /**
+     * Return true if the animation was stopped, or if a non-looping animation
+     * has displayed its last frame for its full duration.
+     */
+    bool isDone() const { return mIsDone; }
+
+    /** Return the index of the current frame. */
+    uint8_t getFrame() const { return mFrame; }
+
+    /** Force the next `tick()` to write all digits of the current frame. */
+    void invalidate() { mDrawnFrame = kNoFrame; }
+
+    /**
+     * Advance the animation to the frame which is due at `nowMillis`, and
+     * write the digits which changed. Call this frequently from the global
+     * `loop()`.
+     *
+     * @return true if anything was written to the LED module, so that the
+     *    caller can flush the LED module only when needed
+     */
+    bool tick(uint16_t nowMillis) {
+      if (mIsDone) return false;
+
+      if (! mIsStarted) {
+        mIsStarted = true;
+        mFrameStartMillis = nowMillis;
+        return drawFrame(mFrame);
+      }
+
+      while (true) {
+        uint16_t duration = frameDuration(mFrame);
+        if ((uint16_t) (nowMillis - mFrameStartMillis) < duration) break;
+
+        mFrameStartMillis += duration;
+        if (! advanceFrame()) break;
+      }
+      return drawFrame(mFrame);
+    }
+
+    /**
+     * Advance the animation by exactly one frame, regardless of its duration,
+     * and write the digits which changed. The new frame starts at
+     * `nowMillis`. The first call after `play()` writes the first frame. Used
+     * to single-step a paused animation.
+     *
+     * @return true if anything was written to the LED module
+     */
+    bool nextFrame(uint16_t nowMillis) {
+      if (mIsDone) return false;
+      if (! mIsStarted) return tick(nowMillis);
+
+      mFrameStartMillis = nowMillis;
+      if (! advanceFrame()) return false;
+      return drawFrame(mFrame);
+    }
+
+  private:
+    // disable copy-constructor and assignment operator
+    AnimationPlayer(const AnimationPlayer&) = delete;
+    AnimationPlayer& operator=(const AnimationPlayer&) = delete;
+
+    /** Value of mDrawnFrame when the display must be fully redrawn. */
+    static const uint8_t kNoFrame = 255;
+
+    /** Return the duration of `frame`, at least 1 millisecond. */
+    uint16_t frameDuration(uint8_t frame) const {
+      uint16_t duration = (mAnimation.durations)
+          ? pgm_read_word(&mAnimation.durations[frame])
+          : mAnimation.framePeriodMillis;
+      return (duration == 0) ? 1 : duration;
+    }
+
+    /**
+     * Move mFrame to the next frame, or back to the first frame of a looping
+     * animation. Return false if a non-looping animation is done instead.
+     */
+    bool advanceFrame() {
+      if (mFrame + 1 < mAnimation.numFrames) {
+        mFrame++;
+      } else if (mIsLoop) {
+        mFrame = 0;
+      } else {
+        mIsDone = true;
+        return false;
+      }
+      return true;
+    }
+
+    /** Return the patterns of `frame` in PROGMEM. */
+    const uint8_t* framePatterns(uint8_t frame) const {
+      return mAnimation.frames + (uint16_t) frame * mAnimation.numDigits;
+    }
+
+    /**
+     * Write the digits of `frame` which differ from the previously drawn
+     * frame. Return true if anything was written.
+     */
+    bool drawFrame(uint8_t frame) {
+      if (frame == mDrawnFrame) return false;
+
+      const uint8_t* next = framePatterns(frame);
+      uint8_t numDigits = mAnimation.numDigits;
+      bool isWritten = false;
+
+      if (mDrawnFrame == kNoFrame) {
+        mPatternWriter.home();
+        mPatternWriter.writePatterns_P(next, numDigits);
+        isWritten = true;
+      } else {
+        const uint8_t* prev = framePatterns(mDrawnFrame);
+        uint8_t i = 0;
+        while (i < numDigits) {
+          if (pgm_read_byte(prev + i) == pgm_read_byte(next + i)) {
+            i++;
+            continue;
+          }
+          uint8_t start = i;
+          do {
+            i++;
+          } while (i < numDigits
+              && pgm_read_byte(prev + i) != pgm_read_byte(next + i));
+          mPatternWriter.pos(start);
+          mPatternWriter.writePatterns_P(next + start, i - start);
+          isWritten = true;
+        }
+      }
+
+      mDrawnFrame = frame;
+      return isWritten;
+    }
+
+  private:
+    PatternWriter<T_LED_MODULE, T_DIGITS>& mPatternWriter;
+    Animation mAnimation;
+
+    /** The millis when the current frame started. */
+    uint16_t mFrameStartMillis;
+
+    /** Index of the current frame. */
+    uint8_t mFrame;
+
+    /** Index of the frame currently on the display, or kNoFrame. */
+    uint8_t mDrawnFrame;
+
+    bool mIsLoop;
+    bool mIsStarted;
+    bool mIsDone;
+};
+
+}
+
+#endif
@@ -0,0 +1,157 @@
+/*
+MIT License
+
+Copyright (c) 2023 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_SEGMENT_WRITER_BROADCAST_MODULE_H
+#define ACE_SEGMENT_WRITER_BROADCAST_MODULE_H
+
+#include <stdint.h>
+#include "PatternWriter.h" // internal::setModulePatterns()
+
+namespace ace_segment {
+
+/**
+ * A composite module which mirrors the same content onto `T_NUM_MODULES`
+ * identical LED modules of `T_DIGITS` digits each, for example, front and rear
+ * facing displays which show the same reading. A single Writer stack renders
+ * into the BroadcastModule, so the cost of the font lookups and the decimal
+ * conversions is paid once per frame, and only the resulting patterns are
+ * copied to each module.
+ *
+ * A multi-digit write through `setPatternsAt()` is forwarded to the
+ * `setPatternsAt()` of each module if it provides one, otherwise to its
+ * `setPatternAt()`. The `getPatternAt()` and `getBrightness()` methods read
+ * from the first module, since all modules hold the same content.
+ *
+ * @code{.cpp}
+ * using Module = Tm1637Module<TmiInterface, 4>;
+ * Module frontModule(...);
+ * Module rearModule(...);
+ * BroadcastModule<Module, 4, 2> broadcastModule({&frontModule, &rearModule});
+ * PatternWriter<BroadcastModule<Module, 4, 2>> patternWriter(broadcastModule);
+ * NumberWriter<BroadcastModule<Module, 4, 2>> numberWriter(patternWriter);
+ *
+ * void loop() {
+ *   numberWriter.home();
+ *   numberWriter.writeSignedDecimal(reading);
+ *   broadcastModule.flush();
+ * }
+ * @endcode
+ *
+ * @tparam T_LED_MODULE the class of the underlying LED Modules, all of which
+ *    must be the same type
+ * @tparam T_DIGITS number of digits in each underlying LED module
+ * @tparam T_NUM_MODULES number of underlying LED modules
+ */
+template <
+    typename T_LED_MODULE,
+    uint8_t T_DIGITS,
+    uint8_t T_NUM_MODULES>
+class BroadcastModule {
+  static_assert(T_NUM_MODULES > 0, "T_NUM_MODULES must be at least 1");
+
+  public:
+    /**
+     * Constructor.
+     * @param modules array of pointers to the underlying LED modules
+     */
+    explicit BroadcastModule(T_LED_MODULE* const (&modules)[T_NUM_MODULES]) {
+      for (uint8_t i = 0; i < T_NUM_MODULES; ++i) {
+        mModules[i] = modules[i];
+      }
+    }
+
+    /** Return the underlying LED module at index `i`. */
+    T_LED_MODULE& ledModule(uint8_t i) const { return *mModules[i]; }
+
+    /** Return the number of underlying LED modules. */
+    uint8_t numModules() const { return T_NUM_MODULES; }
+
+    /** Return the number of digits of each module. */
+    uint8_t size() const { return T_DIGITS; }
+
+    /** Set the pattern at `pos` on all modules. */
+    void setPatternAt(uint8_t pos, uint8_t pattern) {
+      if (pos >= T_DIGITS) return;
+      for (uint8_t i = 0; i < T_NUM_MODULES; ++i) {
+        mModules[i]->setPatternAt(pos, pattern);
+      }
+    }
+
+    /** Set the `len` patterns starting at `pos` on all modules. */
+    void setPatternsAt(uint8_t pos, const uint8_t patterns[], uint8_t len) {
+      if (pos >= T_DIGITS) return;
+      if (len > T_DIGITS - pos) len = T_DIGITS - pos;
+      for (uint8_t i = 0; i < T_NUM_MODULES; ++i) {
+        internal::setModulePatterns(*mModules[i], pos, patterns, len);
+      }
+    }
+
+    /** Return the pattern at `pos` of the first module. */
+    uint8_t getPatternAt(uint8_t pos) const {
+      if (pos >= T_DIGITS) return 0;
+      return mModules[0]->getPatternAt(pos);
+    }
+
+    /** Set or clear the decimal point at `pos` on all modules. */
+    void setDecimalPointAt(uint8_t pos, bool state = true) {
+      if (pos >= T_DIGITS) return;
+      for (uint8_t i = 0; i < T_NUM_MODULES; ++i) {
+        mModules[i]->setDecimalPointAt(pos, state);
+      }
+    }
+
+    /** Set the brightness of all modules. */
+    void setBrightness(uint8_t brightness) {
+      for (uint8_t i = 0; i < T_NUM_MODULES; ++i) {
+        mModules[i]->setBrightness(brightness);
+      }
+    }
+
+    /** Get the brightness of the first module. */
+    uint8_t getBrightness() const {
+      return mModules[0]->getBrightness();
+    }
+
+    /**
+     * Call `flush()` on each underlying module. This requires `T_LED_MODULE`
+     * to provide a `flush()` method.
+     */
+    void flush() {
+      for (uint8_t i = 0; i < T_NUM_MODULES; ++i) {
+        mModules[i]->flush();
+      }
+    }
+
+  private:
+    // disable copy-constructor and assignment operator
+    BroadcastModule(const BroadcastModule&) = delete;
+    BroadcastModule& operator=(const BroadcastModule&) = delete;
+
+  private:
+    T_LED_MODULE* mModules[T_NUM_MODULES];
+};
+
+} // ace_segment
+
+#endif
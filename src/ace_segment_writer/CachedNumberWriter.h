@@ -0,0 +1,211 @@
+/*
+MIT License
+
+Copyright (c) 2023 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_SEGMENT_WRITER_CACHED_NUMBER_WRITER_H
+#define ACE_SEGMENT_WRITER_CACHED_NUMBER_WRITER_H
+
+#include <stdint.h>
+#include "PatternWriter.h"
+#include "NumberWriter.h"
+
+namespace ace_segment {
+
+namespace internal {
+
+/**
+ * The arguments and the result of the last write of a cached Writer. The
+ * `format` identifies the method, and 0 (the value-initialized state) means
+ * that the cache is empty.
+ */
+struct WriteCache {
+  /** Value of `format` which matches nothing. */
+  static const uint8_t kFormatNone = 0;
+
+  /** Return true if the last write had the same arguments. */
+  bool matches(uint8_t f, int32_t v, int8_t b, uint8_t p) const {
+    return format == f && value == v && boxSize == b && pos == p;
+  }
+
+  /** Remember the arguments of a write, and the cursor after it. */
+  void set(uint8_t f, int32_t v, int8_t b, uint8_t p, uint8_t e, uint8_t w) {
+    format = f;
+    value = v;
+    boxSize = b;
+    pos = p;
+    endPos = e;
+    written = w;
+  }
+
+  int32_t value;
+  uint8_t format;
+  int8_t boxSize;
+  uint8_t pos;
+  uint8_t endPos;
+  uint8_t written;
+};
+
+} // internal
+
+/**
+ * A NumberWriter which remembers the arguments of its last write, and does
+ * nothing if it is called again with the same value, box size and cursor
+ * position. The cursor is still moved to where the write would have left it,
+ * and the return value is the same, so a cached write can be substituted for
+ * the NumberWriter method of the same name. Use one instance per field of
+ * the display:
+ *
+ * @code{.cpp}
+ * NumberWriter<LedModule> numberWriter(patternWriter);
+ * CachedNumberWriter<LedModule> pressureField(numberWriter);
+ *
+ * void loop() {
+ *   numberWriter.home();
+ *   pressureField.writeUnsignedDecimal(readPressure(), 4);
+ *   ...
+ * }
+ * @endcode
+ *
+ * The cache assumes that nothing else writes to the digits of the field. If
+ * something does (e.g. `clear()`), call `invalidate()`.
+ *
+ * @tparam T_LED_MODULE the class of the underlying LED Module, often LedModule
+ *    but other classes with the same generic public methods can be substituted
+ * @tparam T_DIGITS number of digits of the LED module if known at compile
+ *    time, which allows the bounds checks and loops to be optimized by the
+ *    compiler; or 0 (default) to use `T_LED_MODULE::size()` at runtime
+ * @tparam T_STORAGE storage policy of the digit patterns of the NumberWriter,
+ *    FlashStorage (default) or RamStorage
+ */
+template <
+    typename T_LED_MODULE,
+    uint8_t T_DIGITS = 0,
+    typename T_STORAGE = FlashStorage>
+class CachedNumberWriter {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param numberWriter instance of
+     *    NumberWriter<T_LED_MODULE, T_DIGITS, T_STORAGE>
+     */
+    explicit CachedNumberWriter(
+        NumberWriter<T_LED_MODULE, T_DIGITS, T_STORAGE>& numberWriter) :
+        mNumberWriter(numberWriter),
+        mCache()
+    {}
+
+    /** Get the underlying LedModule. */
+    T_LED_MODULE& ledModule() { return mNumberWriter.ledModule(); }
+
+    /** Get the underlying PatternWriter. */
+    PatternWriter<T_LED_MODULE, T_DIGITS>& patternWriter() {
+      return mNumberWriter.patternWriter();
+    }
+
+    /** Get the underlying NumberWriter. */
+    NumberWriter<T_LED_MODULE, T_DIGITS, T_STORAGE>& numberWriter() {
+      return mNumberWriter;
+    }
+
+    /** Forget the last write, so that the next write is always performed. */
+    void invalidate() { mCache.format = internal::WriteCache::kFormatNone; }
+
+    /** Same as NumberWriter::writeUnsignedDecimal(), if changed. */
+    uint8_t writeUnsignedDecimal(uint16_t num, int8_t boxSize = 0) {
+      uint8_t pos = patternWriter().pos();
+      if (mCache.matches(kFormatUnsigned, num, boxSize, pos)) return skip();
+      uint8_t written = mNumberWriter.writeUnsignedDecimal(num, boxSize);
+      return update(kFormatUnsigned, num, boxSize, pos, written);
+    }
+
+    /** Same as NumberWriter::writeSignedDecimal(), if changed. */
+    uint8_t writeSignedDecimal(int16_t num, int8_t boxSize = 0) {
+      uint8_t pos = patternWriter().pos();
+      if (mCache.matches(kFormatSigned, num, boxSize, pos)) return skip();
+      uint8_t written = mNumberWriter.writeSignedDecimal(num, boxSize);
+      return update(kFormatSigned, num, boxSize, pos, written);
+    }
+
+    /** Same as NumberWriter::writeUnsignedDecimal32(), if changed. */
+    uint8_t writeUnsignedDecimal32(uint32_t num, int8_t boxSize = 0) {
+      uint8_t pos = patternWriter().pos();
+      if (mCache.matches(kFormatUnsigned32, (int32_t) num, boxSize, pos)) {
+        return skip();
+      }
+      uint8_t written = mNumberWriter.writeUnsignedDecimal32(num, boxSize);
+      return update(kFormatUnsigned32, (int32_t) num, boxSize, pos, written);
+    }
+
+    /** Same as NumberWriter::writeSignedDecimal32(), if changed. */
+    uint8_t writeSignedDecimal32(int32_t num, int8_t boxSize = 0) {
+      uint8_t pos = patternWriter().pos();
+      if (mCache.matches(kFormatSigned32, num, boxSize, pos)) return skip();
+      uint8_t written = mNumberWriter.writeSignedDecimal32(num, boxSize);
+      return update(kFormatSigned32, num, boxSize, pos, written);
+    }
+
+    /** Same as NumberWriter::writeFixed(), if changed. */
+    uint8_t writeFixed(int32_t value, uint8_t fractionDigits,
+        int8_t boxSize = 0) {
+      uint8_t format = kFormatFixed + fractionDigits;
+      uint8_t pos = patternWriter().pos();
+      if (mCache.matches(format, value, boxSize, pos)) return skip();
+      uint8_t written = mNumberWriter.writeFixed(
+          value, fractionDigits, boxSize);
+      return update(format, value, boxSize, pos, written);
+    }
+
+  private:
+    // disable copy-constructor and assignment operator
+    CachedNumberWriter(const CachedNumberWriter&) = delete;
+    CachedNumberWriter& operator=(const CachedNumberWriter&) = delete;
+
+    static const uint8_t kFormatUnsigned = 1;
+    static const uint8_t kFormatSigned = 2;
+    static const uint8_t kFormatUnsigned32 = 3;
+    static const uint8_t kFormatSigned32 = 4;
+    /** Followed by one format for each value of fractionDigits. */
+    static const uint8_t kFormatFixed = 5;
+
+    /** Move the cursor as the cached write did, and return its result. */
+    uint8_t skip() {
+      patternWriter().pos(mCache.endPos);
+      return mCache.written;
+    }
+
+    /** Remember a write which was just performed, and return `written`. */
+    uint8_t update(uint8_t format, int32_t value, int8_t boxSize, uint8_t pos,
+        uint8_t written) {
+      mCache.set(format, value, boxSize, pos, patternWriter().pos(), written);
+      return written;
+    }
+
+  private:
+    NumberWriter<T_LED_MODULE, T_DIGITS, T_STORAGE>& mNumberWriter;
+    internal::WriteCache mCache;
+};
+
+}
+
+#endif
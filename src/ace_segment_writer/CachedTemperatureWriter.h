@@ -0,0 +1,194 @@
+/*
+MIT License
+
+Copyright (c) 2023 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_SEGMENT_WRITER_CACHED_TEMPERATURE_WRITER_H
+#define ACE_SEGMENT_WRITER_CACHED_TEMPERATURE_WRITER_H
+
+#include <stdint.h>
+#include "PatternWriter.h"
+#include "TemperatureWriter.h"
+#include "CachedNumberWriter.h" // internal::WriteCache
+
+namespace ace_segment {
+
+/**
+ * A TemperatureWriter which remembers the arguments of its last write, and
+ * does nothing if it is called again with the same temperature, box size,
+ * unit and cursor position. The cursor is still moved to where the write would
+ * have left it, and the return value is the same. Use one instance per field
+ * of the display. See CachedNumberWriter.
+ *
+ * @tparam T_LED_MODULE the class of the underlying LED Module, often LedModule
+ *    but other classes with the same generic public methods can be substituted
+ * @tparam T_DIGITS number of digits of the LED module if known at compile
+ *    time, which allows the bounds checks and loops to be optimized by the
+ *    compiler; or 0 (default) to use `T_LED_MODULE::size()` at runtime
+ * @tparam T_STORAGE storage policy of the digit patterns of the NumberWriter,
+ *    FlashStorage (default) or RamStorage
+ */
+template <
+    typename T_LED_MODULE,
+    uint8_t T_DIGITS = 0,
+    typename T_STORAGE = FlashStorage>
+class CachedTemperatureWriter {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param temperatureWriter instance of
+     *    TemperatureWriter<T_LED_MODULE, T_DIGITS, T_STORAGE>
+     */
+    explicit CachedTemperatureWriter(
+        TemperatureWriter<T_LED_MODULE, T_DIGITS, T_STORAGE>&
+            temperatureWriter) :
+        mTemperatureWriter(temperatureWriter),
+        mCache()
+    {}
+
+    /** Get the underlying LedModule. */
+    T_LED_MODULE& ledModule() { return mTemperatureWriter.ledModule(); }
+
+    /** Get the underlying PatternWriter. */
+    PatternWriter<T_LED_MODULE, T_DIGITS>& patternWriter() {
+      return mTemperatureWriter.patternWriter();
+    }
+
+    /** Get the underlying TemperatureWriter. */
+    TemperatureWriter<T_LED_MODULE, T_DIGITS, T_STORAGE>& temperatureWriter() {
+      return mTemperatureWriter;
+    }
+
+    /** Forget the last write, so that the next write is always performed. */
+    void invalidate() { mCache.format = internal::WriteCache::kFormatNone; }
+
+    /** Same as TemperatureWriter::writeTemp(), if changed. */
+    uint8_t writeTemp(int16_t temp, int8_t boxSize = 0) {
+      uint8_t pos = patternWriter().pos();
+      if (mCache.matches(kFormatTemp, temp, boxSize, pos)) return skip();
+      uint8_t written = mTemperatureWriter.writeTemp(temp, boxSize);
+      return update(kFormatTemp, temp, boxSize, pos, written);
+    }
+
+    /** Same as TemperatureWriter::writeTempDeg(), if changed. */
+    uint8_t writeTempDeg(int16_t temp, int8_t boxSize = 0) {
+      uint8_t pos = patternWriter().pos();
+      if (mCache.matches(kFormatTempDeg, temp, boxSize, pos)) return skip();
+      uint8_t written = mTemperatureWriter.writeTempDeg(temp, boxSize);
+      return update(kFormatTempDeg, temp, boxSize, pos, written);
+    }
+
+    /** Same as TemperatureWriter::writeTempDegC(), if changed. */
+    uint8_t writeTempDegC(int16_t temp, int8_t boxSize = 0) {
+      uint8_t pos = patternWriter().pos();
+      if (mCache.matches(kFormatTempDegC, temp, boxSize, pos)) return skip();
+      uint8_t written = mTemperatureWriter.writeTempDegC(temp, boxSize);
+      return update(kFormatTempDegC, temp, boxSize, pos, written);
+    }
+
+    /** Same as TemperatureWriter::writeTempDegF(), if changed. */
+    uint8_t writeTempDegF(int16_t temp, int8_t boxSize = 0) {
+      uint8_t pos = patternWriter().pos();
+      if (mCache.matches(kFormatTempDegF, temp, boxSize, pos)) return skip();
+      uint8_t written = mTemperatureWriter.writeTempDegF(temp, boxSize);
+      return update(kFormatTempDegF, temp, boxSize, pos, written);
+    }
+
+    /** Same as TemperatureWriter::writeTempTenths(), if changed. */
+    uint8_t writeTempTenths(int16_t tenths, int8_t boxSize = 0) {
+      uint8_t pos = patternWriter().pos();
+      if (mCache.matches(kFormatTempTenths, tenths, boxSize, pos)) {
+        return skip();
+      }
+      uint8_t written = mTemperatureWriter.writeTempTenths(tenths, boxSize);
+      return update(kFormatTempTenths, tenths, boxSize, pos, written);
+    }
+
+    /** Same as TemperatureWriter::writeTempTenthsDeg(), if changed. */
+    uint8_t writeTempTenthsDeg(int16_t tenths, int8_t boxSize = 0) {
+      uint8_t pos = patternWriter().pos();
+      if (mCache.matches(kFormatTempTenthsDeg, tenths, boxSize, pos)) {
+        return skip();
+      }
+      uint8_t written = mTemperatureWriter.writeTempTenthsDeg(tenths, boxSize);
+      return update(kFormatTempTenthsDeg, tenths, boxSize, pos, written);
+    }
+
+    /** Same as TemperatureWriter::writeTempTenthsDegC(), if changed. */
+    uint8_t writeTempTenthsDegC(int16_t tenths, int8_t boxSize = 0) {
+      uint8_t pos = patternWriter().pos();
+      if (mCache.matches(kFormatTempTenthsDegC, tenths, boxSize, pos)) {
+        return skip();
+      }
+      uint8_t written = mTemperatureWriter.writeTempTenthsDegC(
+          tenths, boxSize);
+      return update(kFormatTempTenthsDegC, tenths, boxSize, pos, written);
+    }
+
+    /** Same as TemperatureWriter::writeTempTenthsDegF(), if changed. */
+    uint8_t writeTempTenthsDegF(int16_t tenths, int8_t boxSize = 0) {
+      uint8_t pos = patternWriter().pos();
+      if (mCache.matches(kFormatTempTenthsDegF, tenths, boxSize, pos)) {
+        return skip();
+      }
+      uint8_t written = mTemperatureWriter.writeTempTenthsDegF(
+          tenths, boxSize);
+      return update(kFormatTempTenthsDegF, tenths, boxSize, pos, written);
+    }
+
+  private:
+    // disable copy-constructor and assignment operator
+    CachedTemperatureWriter(const CachedTemperatureWriter&) = delete;
+    CachedTemperatureWriter& operator=(const CachedTemperatureWriter&) =
+        delete;
+
+    static const uint8_t kFormatTemp = 1;
+    static const uint8_t kFormatTempDeg = 2;
+    static const uint8_t kFormatTempDegC = 3;
+    static const uint8_t kFormatTempDegF = 4;
+    static const uint8_t kFormatTempTenths = 5;
+    static const uint8_t kFormatTempTenthsDeg = 6;
+    static const uint8_t kFormatTempTenthsDegC = 7;
+    static const uint8_t kFormatTempTenthsDegF = 8;
+
+    /** Move the cursor as the cached write did, and return its result. */
+    uint8_t skip() {
+      patternWriter().pos(mCache.endPos);
+      return mCache.written;
+    }
+
+    /** Remember a write which was just performed, and return `written`. */
+    uint8_t update(uint8_t format, int32_t value, int8_t boxSize, uint8_t pos,
+        uint8_t written) {
+      mCache.set(format, value, boxSize, pos, patternWriter().pos(), written);
+      return written;
+    }
+
+  private:
+    TemperatureWriter<T_LED_MODULE, T_DIGITS, T_STORAGE>& mTemperatureWriter;
+    internal::WriteCache mCache;
+};
+
+}
+
+#endif
@@ -0,0 +1,208 @@
+/*
+MIT License
+
+Copyright (c) 2023 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_SEGMENT_WRITER_CHAINED_MODULE_H
+#define ACE_SEGMENT_WRITER_CHAINED_MODULE_H
+
+#include <stdint.h>
+#include "PatternWriter.h" // internal::setModulePatterns()
+
+namespace ace_segment {
+
+/**
+ * A composite module which concatenates `T_NUM_MODULES` identical LED modules
+ * of `T_MODULE_DIGITS` digits each into a single logical display of
+ * `T_MODULE_DIGITS * T_NUM_MODULES` digits. The Writer classes (e.g.
+ * PatternWriter, NumberWriter, StringWriter, StringScroller) can then render
+ * across the full width of all the modules. The digit at logical position
+ * `pos` is located on module `pos / T_MODULE_DIGITS` at digit
+ * `pos % T_MODULE_DIGITS`. Both are divisions by a compile-time constant,
+ * which the compiler reduces to a shift and mask when `T_MODULE_DIGITS` is a
+ * power of 2.
+ *
+ * A range write through `setPatternsAt()` is split into one contiguous chunk
+ * per underlying module. Each chunk is forwarded to the `setPatternsAt()` of
+ * that module if it provides one, otherwise to its `setPatternAt()`. The
+ * modules which received a write since the last `flush()` are remembered, so
+ * that a full-width redraw causes exactly one `flush()` per physical module,
+ * and a partial redraw flushes only the modules which were touched.
+ *
+ * @code{.cpp}
+ * using Module = Max7219Module<HardSpiInterface, 8>;
+ * Module module0(...);
+ * ...
+ * Module module3(...);
+ * using Chain = ChainedModule<Module, 8, 4>;
+ * Chain chainedModule({&module0, &module1, &module2, &module3});
+ * PatternWriter<Chain, Chain::kNumDigits> patternWriter(chainedModule);
+ * CharWriter<Chain, Chain::kNumDigits> charWriter(patternWriter);
+ * StringScroller<Chain, Chain::kNumDigits> stringScroller(charWriter);
+ * ...
+ *
+ * void loop() {
+ *   if (stringScroller.tick(millis())) {
+ *     chainedModule.flush();
+ *   }
+ * }
+ * @endcode
+ *
+ * @tparam T_LED_MODULE the class of the underlying LED Modules, all of which
+ *    must be the same type
+ * @tparam T_MODULE_DIGITS number of digits in each underlying LED module
+ * @tparam T_NUM_MODULES number of underlying LED modules, at most 16
+ */
+template <
+    typename T_LED_MODULE,
+    uint8_t T_MODULE_DIGITS,
+    uint8_t T_NUM_MODULES>
+class ChainedModule {
+  static_assert(T_NUM_MODULES > 0 && T_NUM_MODULES <= 16,
+      "T_NUM_MODULES must be between 1 and 16");
+  static_assert(T_MODULE_DIGITS * T_NUM_MODULES <= 255,
+      "Total number of digits must be less than 256");
+
+  public:
+    /** Total number of digits across all modules. */
+    static const uint8_t kNumDigits = T_MODULE_DIGITS * T_NUM_MODULES;
+
+    /**
+     * Constructor.
+     * @param modules array of pointers to the underlying LED modules, ordered
+     *    from the left most (position 0) to the right most module
+     */
+    explicit ChainedModule(T_LED_MODULE* const (&modules)[T_NUM_MODULES]) :
+        mDirtyModules(0)
+    {
+      for (uint8_t i = 0; i < T_NUM_MODULES; ++i) {
+        mModules[i] = modules[i];
+      }
+    }
+
+    /** Return the underlying LED module at index `i`. */
+    T_LED_MODULE& ledModule(uint8_t i) const { return *mModules[i]; }
+
+    /** Return the number of underlying LED modules. */
+    uint8_t numModules() const { return T_NUM_MODULES; }
+
+    /** Return the number of digits across all modules. */
+    uint8_t size() const { return kNumDigits; }
+
+    /** Set the pattern at the logical digit `pos`. */
+    void setPatternAt(uint8_t pos, uint8_t pattern) {
+      if (pos >= kNumDigits) return;
+      uint8_t i = pos / T_MODULE_DIGITS;
+      mModules[i]->setPatternAt(pos % T_MODULE_DIGITS, pattern);
+      markDirty(i);
+    }
+
+    /**
+     * Set the `len` patterns starting at the logical digit `pos`, calling the
+     * underlying modules once per module.
+     */
+    void setPatternsAt(uint8_t pos, const uint8_t patterns[], uint8_t len) {
+      if (pos >= kNumDigits) return;
+      if (len > kNumDigits - pos) len = kNumDigits - pos;
+
+      uint8_t i = pos / T_MODULE_DIGITS;
+      uint8_t digit = pos % T_MODULE_DIGITS;
+      while (len > 0) {
+        uint8_t n = T_MODULE_DIGITS - digit;
+        if (n > len) n = len;
+        internal::setModulePatterns(*mModules[i], digit, patterns, n);
+        markDirty(i);
+        patterns += n;
+        len -= n;
+        digit = 0;
+        i++;
+      }
+    }
+
+    /** Return the pattern at the logical digit `pos`. */
+    uint8_t getPatternAt(uint8_t pos) const {
+      if (pos >= kNumDigits) return 0;
+      return mModules[pos / T_MODULE_DIGITS]->getPatternAt(
+          pos % T_MODULE_DIGITS);
+    }
+
+    /** Set or clear the decimal point at the logical digit `pos`. */
+    void setDecimalPointAt(uint8_t pos, bool state = true) {
+      if (pos >= kNumDigits) return;
+      uint8_t i = pos / T_MODULE_DIGITS;
+      mModules[i]->setDecimalPointAt(pos % T_MODULE_DIGITS, state);
+      markDirty(i);
+    }
+
+    /** Set the brightness of all underlying modules. */
+    void setBrightness(uint8_t brightness) {
+      for (uint8_t i = 0; i < T_NUM_MODULES; ++i) {
+        mModules[i]->setBrightness(brightness);
+      }
+    }
+
+    /** Get the brightness of the first module. */
+    uint8_t getBrightness() const {
+      return mModules[0]->getBrightness();
+    }
+
+    /** Return true if module `i` was written since the last `flush()`. */
+    bool isModuleDirty(uint8_t i) const {
+      return mDirtyModules & ((uint16_t) 1 << i);
+    }
+
+    /**
+     * Forget which modules were written. Useful if the application flushes the
+     * modules itself.
+     */
+    void clearDirtyModules() { mDirtyModules = 0; }
+
+    /**
+     * Call `flush()` on each underlying module which was written since the
+     * last call, then clear the dirty flags. This requires `T_LED_MODULE` to
+     * provide a `flush()` method (e.g. Max7219Module, Ht16k33Module,
+     * Tm1637Module).
+     */
+    void flush() {
+      for (uint8_t i = 0; i < T_NUM_MODULES; ++i) {
+        if (isModuleDirty(i)) mModules[i]->flush();
+      }
+      mDirtyModules = 0;
+    }
+
+  private:
+    // disable copy-constructor and assignment operator
+    ChainedModule(const ChainedModule&) = delete;
+    ChainedModule& operator=(const ChainedModule&) = delete;
+
+    void markDirty(uint8_t i) { mDirtyModules |= ((uint16_t) 1 << i); }
+
+  private:
+    T_LED_MODULE* mModules[T_NUM_MODULES];
+
+    /** Bit i is set if module i was written since the last flush(). */
+    uint16_t mDirtyModules;
+};
+
+} // ace_segment
+
+#endif
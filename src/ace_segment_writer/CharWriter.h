@@ -28,6 +28,7 @@ SOFTWARE.
 #include <stdint.h>
 #include <Arduino.h> // pgm_read_byte()
 #include "PatternWriter.h"
+#include "PatternStorage.h"
 
 namespace ace_segment {
 
@@ -40,47 +41,132 @@ namespace ace_segment {
  */
 const uint8_t kPatternUnknown = 0b00000000;
 
-/** Number of characters in the kCharPatterns default ASCII character set. */
+/** Number of characters in the kCharPatterns ASCII character set. */
 const uint8_t kNumCharPatterns = 128;
 
-/** Segment patterns for the ASCII character set. */
+/**
+ * Segment patterns for the ASCII character set (0-127). Most applications
+ * should use the smaller kCharFont instead.
+ */
 extern const uint8_t kCharPatterns[kNumCharPatterns];
 
+/** The first character of kPrintableCharPatterns, the space character. */
+const uint8_t kFirstPrintableChar = 0x20;
+
+/** Number of characters in kPrintableCharPatterns, 0x20 to 0x7E. */
+const uint8_t kNumPrintableCharPatterns = 95;
+
+/** Segment patterns for the printable ASCII characters (0x20-0x7E). */
+extern const uint8_t kPrintableCharPatterns[kNumPrintableCharPatterns];
+
+/**
+ * A dense font which maps the contiguous range of characters
+ * `[firstChar, firstChar + numChars)` to the segment patterns in `patterns`,
+ * which is stored in PROGMEM flash memory. Characters outside of the range are
+ * displayed as kPatternUnknown.
+ */
+struct CharFont {
+  /** Array of `numChars` segment patterns in PROGMEM. */
+  const uint8_t* patterns;
+
+  /** The character corresponding to `patterns[0]`. */
+  uint8_t firstChar;
+
+  /** Number of characters in `patterns`. */
+  uint8_t numChars;
+};
+
+/** The default font, the printable ASCII characters 0x20 to 0x7E. */
+const CharFont kCharFont = {
+  kPrintableCharPatterns, kFirstPrintableChar, kNumPrintableCharPatterns
+};
+
 /**
  * The CharWriter supports mapping of an 8-bit character set to segment patterns
- * supported by LedModule. By default, the ASCII characters (0-127) is
- * provided, but can be overridden with a user-defined character set.
+ * supported by LedModule. By default, the printable ASCII characters
+ * (0x20-0x7E) are provided by kCharFont, but the font can be replaced with a
+ * user-defined dense font (CharFont) starting at an arbitrary character. A
+ * sparse font of a few symbols is supported by the SparseCharWriter.
+ *
+ * The lookup is O(1), with a single bounds check. The `T_STORAGE` policy
+ * determines whether the font is read from PROGMEM (FlashStorage) or from
+ * ordinary memory (RamStorage).
  *
  * @tparam T_LED_MODULE the class of the underlying LED Module, often LedModule
  *    but other classes with the same generic public methods can be substituted
+ * @tparam T_DIGITS number of digits of the LED module if known at compile
+ *    time, which allows the bounds checks and loops to be optimized by the
+ *    compiler; or 0 (default) to use `T_LED_MODULE::size()` at runtime
+ * @tparam T_STORAGE storage policy of the font, FlashStorage (default) or
+ *    RamStorage
  */
-template <typename T_LED_MODULE>
+template <
+    typename T_LED_MODULE,
+    uint8_t T_DIGITS = 0,
+    typename T_STORAGE = FlashStorage>
 class CharWriter {
   public:
     /**
-     * Constructor.
-     * @param patternWriter reference to PatternWriter<T_LED_MODULE>
-     * @param charPatterns (optional) the font, consisting of an array of
-     *    7-segment character patterns in PROGMEM flash memory (default: a
-     *    pre-defined font of 128 characters in the ASCII character set)
+     * Constructor using the default font of the printable ASCII characters
+     * (0x20-0x7E), read from the memory selected by `T_STORAGE`.
+     * @param patternWriter reference to PatternWriter<T_LED_MODULE, T_DIGITS>
+     */
+    explicit CharWriter(PatternWriter<T_LED_MODULE, T_DIGITS>& patternWriter) :
+        mPatternWriter(patternWriter),
+        mCharPatterns(T_STORAGE::printableCharPatterns()),
+        mFirstChar(kFirstPrintableChar),
+        mNumChars(kNumPrintableCharPatterns)
+    {}
+
+    /**
+     * Constructor using a dense font in PROGMEM. Not available with
+     * RamStorage, which reads the font from ordinary memory.
+     * @param patternWriter reference to PatternWriter<T_LED_MODULE, T_DIGITS>
+     * @param font the font, e.g. kCharFont
+     */
+    CharWriter(
+        PatternWriter<T_LED_MODULE, T_DIGITS>& patternWriter,
+        const CharFont& font
+    ) :
+        mPatternWriter(patternWriter),
+        mCharPatterns(font.patterns),
+        mFirstChar(font.firstChar),
+        mNumChars(font.numChars)
+    {
+      static_assert(T_STORAGE::kIsProgmem,
+          "CharWriter with RamStorage supports only the default font");
+    }
+
+    /**
+     * Constructor using an array of patterns starting at character 0. Not
+     * available with RamStorage, which reads the font from ordinary memory.
+     * @param patternWriter reference to PatternWriter<T_LED_MODULE, T_DIGITS>
+     * @param charPatterns the font, consisting of an array of 7-segment
+     *    character patterns in PROGMEM flash memory (e.g. kCharPatterns)
      * @param numChars (optional) number of characters in charPatterns,
      *    (default: 128)
      */
-    explicit CharWriter(
-        PatternWriter<T_LED_MODULE>& patternWriter,
-        const uint8_t charPatterns[] = kCharPatterns,
+    CharWriter(
+        PatternWriter<T_LED_MODULE, T_DIGITS>& patternWriter,
+        const uint8_t charPatterns[],
         uint8_t numChars = kNumCharPatterns
     ) :
         mPatternWriter(patternWriter),
         mCharPatterns(charPatterns),
+        mFirstChar(0),
         mNumChars(numChars)
-    {}
+    {
+      static_assert(T_STORAGE::kIsProgmem,
+          "CharWriter with RamStorage supports only the default font");
+    }
 
     /** Get the underlying LedModule. */
     T_LED_MODULE& ledModule() { return mPatternWriter.ledModule(); }
 
     /** Get the underlying PatternWriter. */
-    PatternWriter<T_LED_MODULE>& patternWriter() { return mPatternWriter; }
+    PatternWriter<T_LED_MODULE, T_DIGITS>& patternWriter() {
+      return mPatternWriter;
+    }
 
     /** Return the number of digits supported by this display instance. */
     uint8_t size() const { return mPatternWriter.size(); }
@@ -88,6 +174,9 @@ class CharWriter {
     /** Get number of characters in current character set. */
     uint8_t getNumChars() const { return mNumChars; }
 
+    /** Get the first character of the font. */
+    uint8_t getFirstChar() const { return mFirstChar; }
+
     /** Set the cursor to the beginning. */
     void home() { mPatternWriter.home(); }
 
@@ -98,8 +187,10 @@ class CharWriter {
 
     /** Get segment pattern for character 'c'. */
     uint8_t getPattern(char c) const {
-      uint8_t pattern = ((uint8_t) c < mNumChars)
-          ? pgm_read_byte(&mCharPatterns[(uint8_t) c])
+      // Characters below mFirstChar wrap around to a large index.
+      uint8_t index = (uint8_t) c - mFirstChar;
+      uint8_t pattern = (index < mNumChars)
+          ? T_STORAGE::readPattern(mCharPatterns + index)
           : kPatternUnknown;
       return pattern;
     }
@@ -116,8 +207,9 @@ class CharWriter {
     CharWriter& operator=(const CharWriter&) = delete;
 
   private:
-    PatternWriter<T_LED_MODULE>& mPatternWriter;
+    PatternWriter<T_LED_MODULE, T_DIGITS>& mPatternWriter;
     const uint8_t* const mCharPatterns;
+    uint8_t const mFirstChar;
     uint8_t const mNumChars;
 };
 
@@ -32,23 +32,36 @@ SOFTWARE.
 namespace ace_segment {
 
 /**
- * The ClockWriter writes "hh:mm" and "yyyy" to the LedModule. A few other
- * characters are supported.
+ * The ClockWriter writes "hh:mm", "hh:mm:ss" and "yyyy" to the LedModule. A few
+ * other characters are supported. See IncrementalClockWriter for a clock which
+ * rewrites only the digits which changed.
+ *
+ * @tparam T_LED_MODULE the class of the underlying LED Module, often LedModule
+ *    but other classes with the same generic public methods can be substituted
+ * @tparam T_DIGITS number of digits of the LED module if known at compile
+ *    time, which allows the bounds checks and loops to be optimized by the
+ *    compiler; or 0 (default) to use `T_LED_MODULE::size()` at runtime
+ * @tparam T_STORAGE storage policy of the digit patterns of the NumberWriter,
+ *    FlashStorage (default) or RamStorage
  */
-template <typename T_LED_MODULE>
+template <
+    typename T_LED_MODULE,
+    uint8_t T_DIGITS = 0,
+    typename T_STORAGE = FlashStorage>
 class ClockWriter {
   public:
     /**
      * Constructor.
      *
-     * @param numberWriter instance of NumberWriter<T_LED_MODULE>
+     * @param numberWriter instance of
+     *    NumberWriter<T_LED_MODULE, T_DIGITS, T_STORAGE>
      * @param colonDigit The digit which has the colon (":") character,
      *    mapped to bit 7 (i.e. 'H' segment). In many 4-digit LED clock
      *    display modules, this is digit 1 (counting from the left, 0-based,
      *    so the second digit from the left).
      */
     explicit ClockWriter(
-        NumberWriter<T_LED_MODULE>& numberWriter,
+        NumberWriter<T_LED_MODULE, T_DIGITS, T_STORAGE>& numberWriter,
         uint8_t colonDigit = 1
     ) :
         mNumberWriter(numberWriter),
@@ -59,12 +72,17 @@ class ClockWriter {
     T_LED_MODULE& ledModule() { return mNumberWriter.ledModule(); }
 
     /** Get the underlying PatternWriter. */
-    PatternWriter<T_LED_MODULE>& patternWriter() {
+    PatternWriter<T_LED_MODULE, T_DIGITS>& patternWriter() {
       return mNumberWriter.patternWriter();
     }
 
     /** Get the underlying NumberWriter. */
-    NumberWriter<T_LED_MODULE>& numberWriter() { return mNumberWriter; }
+    NumberWriter<T_LED_MODULE, T_DIGITS, T_STORAGE>& numberWriter() {
+      return mNumberWriter;
+    }
+
+    /** Return the digit which has the colon. */
+    uint8_t getColonDigit() const { return mColonDigit; }
 
     /** Reset cursor to home. */
     void home() { mNumberWriter.home(); }
@@ -91,6 +109,31 @@ class ClockWriter {
       writeColon();
     }
 
+    /**
+     * Write the hour, minute and second in 24-hour format (i.e. leading 0),
+     * and the 2 colons in one-shot, assuming the LED module is a 6-digit
+     * module whose colons (or decimal points) are at `colonDigit` and
+     * `colonDigit + 2`. This is a convenience function.
+     */
+    void writeHourMinuteSecond24(uint8_t hh, uint8_t mm, uint8_t ss) {
+      mNumberWriter.writeDec2(hh);
+      mNumberWriter.writeDec2(mm);
+      mNumberWriter.writeDec2(ss);
+      writeColons();
+    }
+
+    /**
+     * Write the hour, minute and second in 12-hour format (i.e. leading
+     * space), and the 2 colons in one-shot, assuming the same 6-digit module
+     * as writeHourMinuteSecond24(). This is a convenience function.
+     */
+    void writeHourMinuteSecond12(uint8_t hh, uint8_t mm, uint8_t ss) {
+      mNumberWriter.writeDec2(hh, kPatternSpace);
+      mNumberWriter.writeDec2(mm);
+      mNumberWriter.writeDec2(ss);
+      writeColons();
+    }
+
     /**
      * Write the colon symbol between 'hh' and 'mm'.
      *
@@ -100,6 +143,17 @@ class ClockWriter {
       mNumberWriter.patternWriter().setDecimalPointAt(mColonDigit, state);
     }
 
+    /**
+     * Write the colon symbols between 'hh' and 'mm', and between 'mm' and 'ss'
+     * of a 6-digit clock.
+     *
+     * @param state Set to false to turn off the colons.
+     */
+    void writeColons(bool state = true) {
+      writeColon(state);
+      mNumberWriter.patternWriter().setDecimalPointAt(mColonDigit + 2, state);
+    }
+
     /** Clear the entire display. */
     void clear() { mNumberWriter.clear(); }
 
@@ -111,7 +165,7 @@ class ClockWriter {
     ClockWriter(const ClockWriter&) = delete;
     ClockWriter& operator=(const ClockWriter&) = delete;
 
-    NumberWriter<T_LED_MODULE>& mNumberWriter;
+    NumberWriter<T_LED_MODULE, T_DIGITS, T_STORAGE>& mNumberWriter;
     uint8_t const mColonDigit;
 };
 
@@ -0,0 +1,136 @@
+/*
+MIT License
+
+Copyright (c) 2023 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "CompressedAnimation.h"
+
+namespace ace_segment {
+
+namespace internal {
+
+/** Appends bytes to the output buffer of compressAnimationFrames(). */
+class RunEncoder {
+  public:
+    RunEncoder(uint8_t out[], uint16_t outSize) :
+        mOut(out),
+        mOutSize(outSize),
+        mSize(0),
+        mIsOverflow(false)
+    {}
+
+    void append(uint8_t b) {
+      if (mOut) {
+        if (mSize >= mOutSize) {
+          mIsOverflow = true;
+          return;
+        }
+        mOut[mSize] = b;
+      }
+      mSize++;
+    }
+
+    uint16_t size() const { return mIsOverflow ? 0 : mSize; }
+
+  private:
+    uint8_t* const mOut;
+    uint16_t const mOutSize;
+    uint16_t mSize;
+    bool mIsOverflow;
+};
+
+/**
+ * Encode the changes from `prev` to `next`. If `prev` is nullptr, every digit
+ * is written.
+ */
+void encodeFrame(
+    RunEncoder& encoder, const uint8_t prev[], const uint8_t next[],
+    uint8_t numDigits) {
+
+  uint8_t skip = 0;
+  uint8_t i = 0;
+  while (i < numDigits) {
+    if (prev && prev[i] == next[i]) {
+      skip++;
+      i++;
+      continue;
+    }
+    for (; skip > kRunMaxSkip; skip -= kRunMaxSkip) {
+      encoder.append(literalRun(kRunMaxSkip, 0));
+    }
+
+    // Count the changed digits identical to next[i].
+    uint8_t repeat = 1;
+    while (i + repeat < numDigits
+        && repeat < kRunMaxCount
+        && next[i + repeat] == next[i]
+        && ! (prev && prev[i + repeat] == next[i + repeat])) {
+      repeat++;
+    }
+
+    if (repeat >= 2) {
+      encoder.append(repeatRun(skip, repeat));
+      encoder.append(next[i]);
+      i += repeat;
+    } else {
+      // Collect the changed digits up to the start of the next repeat.
+      uint8_t count = 1;
+      while (i + count < numDigits && count < kRunMaxCount) {
+        uint8_t j = i + count;
+        bool isChanged = ! (prev && prev[j] == next[j]);
+        bool isNextChanged = (j + 1 < numDigits)
+            && ! (prev && prev[j + 1] == next[j + 1]);
+        if (! isChanged) break;
+        if (isNextChanged && next[j + 1] == next[j]) break;
+        count++;
+      }
+      encoder.append(literalRun(skip, count));
+      for (uint8_t k = 0; k < count; k++) {
+        encoder.append(next[i + k]);
+      }
+      i += count;
+    }
+    skip = 0;
+  }
+  encoder.append(kRunFrameEnd);
+}
+
+} // internal
+
+uint16_t compressAnimationFrames(
+    const uint8_t frames[], uint8_t numFrames, uint8_t numDigits,
+    uint8_t out[], uint16_t outSize) {
+
+  if (numFrames == 0) return 0;
+
+  internal::RunEncoder encoder(out, outSize);
+  const uint8_t* prev = nullptr;
+  for (uint8_t f = 0; f < numFrames; f++) {
+    const uint8_t* next = frames + (uint16_t) f * numDigits;
+    internal::encodeFrame(encoder, prev, next, numDigits);
+    prev = next;
+  }
+  internal::encodeFrame(encoder, prev, frames, numDigits);
+  return encoder.size();
+}
+
+}
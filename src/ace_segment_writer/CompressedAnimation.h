@@ -0,0 +1,408 @@
+/*
+MIT License
+
+Copyright (c) 2023 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_SEGMENT_WRITER_COMPRESSED_ANIMATION_H
+#define ACE_SEGMENT_WRITER_COMPRESSED_ANIMATION_H
+
+#include <stdint.h>
+#include <Arduino.h> // pgm_read_byte(), pgm_read_word()
+#include "PatternWriter.h"
+
+namespace ace_segment {
+
+/**
+ * Header byte which terminates a frame of a CompressedAnimation. A frame with
+ * no changes from the previous frame consists of only this byte.
+ */
+const uint8_t kRunFrameEnd = 0x00;
+
+/** Bit of the header byte which selects a repeat run. */
+const uint8_t kRunRepeat = 0x80;
+
+/** Maximum number of unchanged digits skipped by a single header byte. */
+const uint8_t kRunMaxSkip = 7;
+
+/** Maximum number of digits written by a single header byte. */
+const uint8_t kRunMaxCount = 15;
+
+/**
+ * Header byte of a literal run, which skips `skip` (0-7) unchanged digits,
+ * then writes the `count` (0-15) patterns which follow the header byte.
+ */
+constexpr uint8_t literalRun(uint8_t skip, uint8_t count) {
+  return (uint8_t) ((skip << 4) | count);
+}
+
+/**
+ * Header byte of a repeat run, which skips `skip` (0-7) unchanged digits, then
+ * writes the single pattern which follows the header byte `count` (1-15)
+ * times.
+ */
+constexpr uint8_t repeatRun(uint8_t skip, uint8_t count) {
+  return (uint8_t) (kRunRepeat | (skip << 4) | count);
+}
+
+/**
+ * An animation whose frames are stored as differences from the previous frame
+ * in PROGMEM. The `data` contains `numFrames + 1` encoded frames:
+ *
+ *  * frame 0, relative to a blank display, which writes every digit,
+ *  * frames 1 to `numFrames - 1`, relative to the previous frame,
+ *  * a loop frame, which changes frame `numFrames - 1` back into frame 0.
+ *
+ * Each encoded frame is a sequence of runs terminated by `kRunFrameEnd`. A run
+ * is a header byte created by `literalRun()` or `repeatRun()`, followed by its
+ * patterns. The runs move a cursor from the left-most digit to the right, so
+ * unchanged digits cost nothing except the skip count of the next run.
+ *
+ * The `data` is normally generated by `compressAnimationFrames()`, then
+ * printed and pasted into the program. It can also be written by hand, for
+ * example the spinning bars of `examples/WriterTester`, which light the same
+ * segments on all 4 digits:
+ *
+ * @code{.cpp}
+ * const uint8_t SPIN_DATA[] PROGMEM = {
+ *   repeatRun(0, 4), 0x03, kRunFrameEnd, // frame 0
+ *   repeatRun(0, 4), 0x06, kRunFrameEnd, // frame 1
+ *   repeatRun(0, 4), 0x0c, kRunFrameEnd, // frame 2
+ *   repeatRun(0, 4), 0x03, kRunFrameEnd, // loop to frame 0
+ * };
+ * const CompressedAnimation SPIN_ANIMATION = {
+ *   SPIN_DATA, // data
+ *   nullptr, // durations
+ *   3, // numFrames
+ *   4, // numDigits
+ *   100, // framePeriodMillis
+ * };
+ * @endcode
+ */
+struct CompressedAnimation {
+  /** Encoded frames in PROGMEM. */
+  const uint8_t* data;
+
+  /**
+   * Array of `numFrames` durations in milliseconds in PROGMEM, or nullptr if
+   * every frame lasts `framePeriodMillis`.
+   */
+  const uint16_t* durations;
+
+  /** Number of frames, excluding the loop frame. */
+  uint8_t numFrames;
+
+  /** Number of digits in each frame. */
+  uint8_t numDigits;
+
+  /** Duration of every frame if `durations` is nullptr. */
+  uint16_t framePeriodMillis;
+};
+
+/**
+ * Encode the raw `frames`, an array of `numFrames * numDigits` patterns, into
+ * the `data` format of a CompressedAnimation. A digit which is identical to
+ * the same digit of the previous frame is skipped, and 2 or more identical
+ * changed digits become a repeat run.
+ *
+ * This is intended to be run once, on a desktop machine using EpoxyDuino or on
+ * a development board, to generate the PROGMEM table of the final program.
+ *
+ * @param frames raw patterns in normal memory
+ * @param numFrames number of frames, at least 1
+ * @param numDigits number of digits in each frame
+ * @param out output buffer, or nullptr to calculate the encoded size only
+ * @param outSize size of `out`
+ * @return the number of encoded bytes, or 0 if `out` is too small
+ */
+uint16_t compressAnimationFrames(
+    const uint8_t frames[], uint8_t numFrames, uint8_t numDigits,
+    uint8_t out[], uint16_t outSize);
+
+/**
+ * Play a CompressedAnimation on the LED module, without blocking. This has the
+ * same behavior as AnimationPlayer, but decodes the frames from PROGMEM one
+ * run at a time, so the cost of a frame is proportional to the number of
+ * digits which changed.
+ *
+ * The decoded frame is kept in a buffer of `T_DIGITS` bytes, or 16 bytes if
+ * `T_DIGITS` is 0, which limits the animation to the first 16 digits of the
+ * LED module. If several frames are due at the same `tick()`, all of them are
+ * decoded into the buffer, and each digit which changed in any of them is
+ * written once.
+ * Each run of changed digits is written with a single
+ * `PatternWriter::writePatterns()`.
+ *
+ * @tparam T_LED_MODULE the class of the underlying LED Module, often LedModule
+ *    but other classes with the same generic public methods can be substituted
+ * @tparam T_DIGITS number of digits of the LED module if known at compile
+ *    time, which allows the bounds checks and loops to be optimized by the
+ *    compiler; or 0 (default) to use `T_LED_MODULE::size()` at runtime
+ */
+template <typename T_LED_MODULE, uint8_t T_DIGITS = 0>
+class CompressedAnimationPlayer {
+  public:
+    /** Constructor. */
+    explicit CompressedAnimationPlayer(
+        PatternWriter<T_LED_MODULE, T_DIGITS>& patternWriter) :
+        mPatternWriter(patternWriter),
+        mAnimation(),
+        mFrameStartMillis(0),
+        mOffset(0),
+        mLoopOffset(0),
+        mDirtyDigits(0),
+        mFrame(0),
+        mIsLoop(false),
+        mIsStarted(false),
+        mIsDone(true),
+        mPatterns()
+    {}
+
+    /** Get the underlying LedModule. */
+    T_LED_MODULE& ledModule() { return mPatternWriter.ledModule(); }
+
+    /** Get the underlying PatternWriter. */
+    PatternWriter<T_LED_MODULE, T_DIGITS>& patternWriter() {
+      return mPatternWriter;
+    }
+
+    /**
+     * Start playing the `animation` from its first frame, which is written by
+     * the next call to `tick()`.
+     *
+     * @param animation the frames to play, copied into the player
+     * @param loop if true (default), restart from the first frame after the
+     *    last frame; if false, stop and keep the last frame on the display
+     */
+    void play(const CompressedAnimation& animation, bool loop = true) {
+      mAnimation = animation;
+      mIsLoop = loop;
+      mIsStarted = false;
+      mIsDone = (animation.numFrames == 0);
+      mFrame = 0;
+      mOffset = 0;
+      mLoopOffset = 0;
+
+      // Frame 0 is encoded relative to a blank display.
+      for (uint8_t i = 0; i < kBufferSize; ++i) {
+        mPatterns[i] = 0;
+      }
+      invalidate();
+    }
+
+    /** Stop the animation, leaving the current frame on the display. */
+    void stop() { mIsDone = true; }
+
+    /**
+     * Return true if the animation was stopped, or if a non-looping animation
+     * has displayed its last frame for its full duration.
+     */
+    bool isDone() const { return mIsDone; }
+
+    /** Return the index of the current frame. */
+    uint8_t getFrame() const { return mFrame; }
+
+    /** Force the next `tick()` to write all digits of the current frame. */
+    void invalidate() { mDirtyDigits = kAllDigits; }
+
+    /**
+     * Advance the animation to the frame which is due at `nowMillis`, and
+     * write the digits which changed. Call this frequently from the global
+     * `loop()`.
+     *
+     * @return true if anything was written to the LED module, so that the
+     *    caller can flush the LED module only when needed
+     */
+    bool tick(uint16_t nowMillis) {
+      if (mIsDone) return false;
+
+      if (! mIsStarted) {
+        mIsStarted = true;
+        mFrameStartMillis = nowMillis;
+        decodeFrame();
+        mLoopOffset = mOffset;
+        return drawDirtyDigits();
+      }
+
+      while (true) {
+        uint16_t duration = frameDuration(mFrame);
+        if ((uint16_t) (nowMillis - mFrameStartMillis) < duration) break;
+
+        mFrameStartMillis += duration;
+        if (! advanceFrame()) break;
+      }
+      return drawDirtyDigits();
+    }
+
+    /**
+     * Advance the animation by exactly one frame, regardless of its duration,
+     * and write the digits which changed. The new frame starts at
+     * `nowMillis`. The first call after `play()` writes the first frame.
+     *
+     * @return true if anything was written to the LED module
+     */
+    bool nextFrame(uint16_t nowMillis) {
+      if (mIsDone) return false;
+      if (! mIsStarted) return tick(nowMillis);
+
+      mFrameStartMillis = nowMillis;
+      if (! advanceFrame()) return false;
+      return drawDirtyDigits();
+    }
+
+  private:
+    // disable copy-constructor and assignment operator
+    CompressedAnimationPlayer(const CompressedAnimationPlayer&) = delete;
+    CompressedAnimationPlayer& operator=(const CompressedAnimationPlayer&) =
+        delete;
+
+    static_assert(T_DIGITS <= 16, "T_DIGITS must be <= 16");
+
+    /** Size of the frame buffer. */
+    static const uint8_t kBufferSize = T_DIGITS ? T_DIGITS : 16;
+
+    /** Value of mDirtyDigits which marks every digit as changed. */
+    static const uint16_t kAllDigits = 0xFFFF;
+
+    /** Return the duration of `frame`, at least 1 millisecond. */
+    uint16_t frameDuration(uint8_t frame) const {
+      uint16_t duration = (mAnimation.durations)
+          ? pgm_read_word(&mAnimation.durations[frame])
+          : mAnimation.framePeriodMillis;
+      return (duration == 0) ? 1 : duration;
+    }
+
+    /** Return the number of digits of the animation which fit the buffer. */
+    uint8_t numDigits() const {
+      uint8_t n = mAnimation.numDigits;
+      return (n < kBufferSize) ? n : kBufferSize;
+    }
+
+    /** Update the digit at `pos` of the buffer, and mark it if changed. */
+    void setPattern(uint8_t pos, uint8_t pattern) {
+      if (pos >= kBufferSize) return;
+      if (mPatterns[pos] == pattern) return;
+      mPatterns[pos] = pattern;
+      mDirtyDigits |= (uint16_t) (1 << pos);
+    }
+
+    /**
+     * Decode the next frame into the buffer, or the first frame again at the
+     * end of a looping animation. Return false if a non-looping animation is
+     * done instead.
+     */
+    bool advanceFrame() {
+      if (mFrame + 1 < mAnimation.numFrames) {
+        decodeFrame();
+        mFrame++;
+      } else if (mIsLoop) {
+        decodeFrame();
+        mOffset = mLoopOffset;
+        mFrame = 0;
+      } else {
+        mIsDone = true;
+        return false;
+      }
+      return true;
+    }
+
+    /** Decode the frame at mOffset into the buffer, and advance mOffset. */
+    void decodeFrame() {
+      const uint8_t* data = mAnimation.data;
+      uint8_t pos = 0;
+      while (true) {
+        uint8_t header = pgm_read_byte(data + mOffset++);
+        if (header == kRunFrameEnd) break;
+
+        pos += (header >> 4) & kRunMaxSkip;
+        uint8_t count = header & kRunMaxCount;
+        if (header & kRunRepeat) {
+          uint8_t pattern = pgm_read_byte(data + mOffset++);
+          for (; count > 0; count--) {
+            setPattern(pos++, pattern);
+          }
+        } else {
+          for (; count > 0; count--) {
+            setPattern(pos++, pgm_read_byte(data + mOffset++));
+          }
+        }
+      }
+    }
+
+    /**
+     * Write each run of digits which changed since the last draw. Return true
+     * if anything was written.
+     */
+    bool drawDirtyDigits() {
+      uint8_t n = numDigits();
+      bool isWritten = false;
+      uint8_t i = 0;
+      while (i < n) {
+        if (! isDirty(i)) {
+          i++;
+          continue;
+        }
+        uint8_t start = i;
+        do {
+          i++;
+        } while (i < n && isDirty(i));
+        mPatternWriter.pos(start);
+        mPatternWriter.writePatterns(mPatterns + start, i - start);
+        isWritten = true;
+      }
+      mDirtyDigits = 0;
+      return isWritten;
+    }
+
+    bool isDirty(uint8_t pos) const {
+      return mDirtyDigits & (uint16_t) (1 << pos);
+    }
+
+  private:
+    PatternWriter<T_LED_MODULE, T_DIGITS>& mPatternWriter;
+    CompressedAnimation mAnimation;
+
+    /** The millis when the current frame started. */
+    uint16_t mFrameStartMillis;
+
+    /** Offset of the next encoded frame in mAnimation.data. */
+    uint16_t mOffset;
+
+    /** Offset of frame 1, which follows the loop frame. */
+    uint16_t mLoopOffset;
+
+    /** Bit mask of the digits which changed since the last draw. */
+    uint16_t mDirtyDigits;
+
+    /** Index of the current frame. */
+    uint8_t mFrame;
+
+    bool mIsLoop;
+    bool mIsStarted;
+    bool mIsDone;
+
+    /** The decoded frame. */
+    uint8_t mPatterns[kBufferSize];
+};
+
+}
+
+#endif
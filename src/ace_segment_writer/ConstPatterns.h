@@ -0,0 +1,152 @@
+/*
+MIT License
+
+Copyright (c) 2023 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_SEGMENT_WRITER_CONST_PATTERNS_H
+#define ACE_SEGMENT_WRITER_CONST_PATTERNS_H
+
+#include <stdint.h>
+#include <Arduino.h> // PROGMEM
+#include "CharWriter.h" // kPatternUnknown
+#include "PatternStorage.h" // internal::ConstPatternTables
+
+namespace ace_segment {
+
+namespace internal {
+
+/** Return the kCharFont segment pattern of the character `c`. */
+constexpr uint8_t constCharPattern(char c) {
+  return (c >= 0x20 && c < 0x7F)
+      ? ConstPatternTables<>::kCharPatterns[c - 0x20]
+      : kPatternUnknown;
+}
+
+/**
+ * Return the pattern of the digit which starts at `s`, with the decimal point
+ * added if the next character is a '.', which is folded into this digit.
+ */
+constexpr uint8_t constDigitPattern(const char* s) {
+  return (*s == '.')
+      ? constCharPattern('.')
+      : constCharPattern(*s) | ((s[1] == '.') ? 0x80 : 0);
+}
+
+/**
+ * Return the number of digits needed to display the string `s`, using the
+ * same '.' folding rules as StringWriter::writeString(): a '.' which follows a
+ * character is rendered as the decimal point of that character, otherwise it
+ * takes a digit of its own.
+ */
+constexpr uint8_t constFoldedLength(
+    const char* s, bool charWasWritten = false) {
+  return (*s == '\0')
+      ? 0
+      : (*s == '.' && charWasWritten)
+          ? constFoldedLength(s + 1, true)
+          : 1 + constFoldedLength(s + 1, *s != '.');
+}
+
+/** Return the pattern of the `k`-th digit of the string `s`. */
+constexpr uint8_t constFoldedPatternAt(
+    const char* s, uint8_t k, bool charWasWritten = false) {
+  return (*s == '.' && charWasWritten)
+      ? constFoldedPatternAt(s + 1, k, true)
+      : (k == 0)
+          ? constDigitPattern(s)
+          : constFoldedPatternAt(s + 1, k - 1, *s != '.');
+}
+
+/** A compile-time list of indexes, similar to C++14 std::index_sequence. */
+template <uint8_t... I>
+struct IndexSequence {};
+
+/** Generate IndexSequence<0, 1, ..., N-1>. */
+template <uint8_t N, uint8_t... I>
+struct MakeIndexSequence : MakeIndexSequence<N - 1, N - 1, I...> {};
+
+template <uint8_t... I>
+struct MakeIndexSequence<0, I...> {
+  typedef IndexSequence<I...> type;
+};
+
+} // internal
+
+/**
+ * An array of segment patterns in PROGMEM, rendered at compile time from a
+ * string literal using the default kCharFont font. The '.' characters are
+ * folded into the preceding digit exactly like StringWriter::writeString(), so
+ * the result can be written using PatternWriter::writePatterns_P() without
+ * looking up any character at runtime. If the application displays only
+ * compile-time text, the 95-byte kPrintableCharPatterns table is not linked in.
+ *
+ * Usually created through the ACE_SEGMENT_WRITER_CONST_PATTERNS() macro:
+ *
+ * @code{.cpp}
+ * ACE_SEGMENT_WRITER_CONST_PATTERNS(ErrLabel, "Err.");
+ *
+ * patternWriter.writePatterns_P(ErrLabel::kPatterns, ErrLabel::kLength);
+ * @endcode
+ *
+ * @tparam T_STRING a class with a `static constexpr const char* value()`
+ *    method which returns the string literal, which must not be empty
+ */
+template <
+    typename T_STRING,
+    typename T_INDEXES = typename internal::MakeIndexSequence<
+        internal::constFoldedLength(T_STRING::value())>::type
+>
+struct ConstPatterns;
+
+template <typename T_STRING, uint8_t... I>
+struct ConstPatterns<T_STRING, internal::IndexSequence<I...>> {
+  static_assert(sizeof...(I) > 0, "String must not be empty");
+
+  /** Number of digits, after folding the '.' characters. */
+  static const uint8_t kLength = sizeof...(I);
+
+  /** Segment patterns in PROGMEM. */
+  static const uint8_t kPatterns[sizeof...(I)];
+};
+
+template <typename T_STRING, uint8_t... I>
+const uint8_t ConstPatterns<T_STRING, internal::IndexSequence<I...>>::kLength;
+
+template <typename T_STRING, uint8_t... I>
+const uint8_t ConstPatterns<T_STRING, internal::IndexSequence<I...>>
+    ::kPatterns[sizeof...(I)] PROGMEM = {
+  internal::constFoldedPatternAt(T_STRING::value(), I)...
+};
+
+}
+
+/**
+ * Define the type `name` as a ConstPatterns rendered from the string literal
+ * `s`, along with a helper class `name##String` which holds the literal.
+ */
+#define ACE_SEGMENT_WRITER_CONST_PATTERNS(name, s) \
+  struct name##String { \
+    static constexpr const char* value() { return s; } \
+  }; \
+  typedef ace_segment::ConstPatterns<name##String> name
+
+#endif
@@ -0,0 +1,271 @@
+/*
+MIT License
+
+Copyright (c) 2023 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_SEGMENT_WRITER_COUNTER_WRITER_H
+#define ACE_SEGMENT_WRITER_COUNTER_WRITER_H
+
+#include <stdint.h>
+#include "PatternWriter.h"
+#include "NumberWriter.h"
+
+namespace ace_segment {
+
+/**
+ * A counter which holds its value as one counter per digit, and rewrites only
+ * the digits changed by `increment()` or `decrement()`. A carry or a borrow
+ * changes the digits from the right-most digit up to the first digit which
+ * did not wrap around, so an increment costs 1 digit most of the time, and
+ * 1.1 digits on average for decimal digits. No division is performed except
+ * in `setValue()`.
+ *
+ * Each digit counts in base 10 by default. A stopwatch or a countdown timer
+ * can give each digit its own radix. For example, "m:ss.hh" on a 5-digit
+ * counter, with the decimal points after the minute and the seconds:
+ *
+ * @code{.cpp}
+ * const uint8_t STOPWATCH_RADIXES[] = {10, 6, 10, 10, 10};
+ * CounterWriter<LedModule> stopwatch(numberWriter, 5, STOPWATCH_RADIXES);
+ *
+ * void setup() {
+ *   ...
+ *   stopwatch.setDecimalPoints(0b00101); // digits 0 and 2
+ *   stopwatch.setValue(0);
+ * }
+ *
+ * void loop() {
+ *   // every 10 milliseconds
+ *   stopwatch.increment();
+ *   ledModule.flush();
+ * }
+ * @endcode
+ *
+ * The counter occupies `numDigits` digits starting at `startPos`, with leading
+ * zeros. It assumes that nothing else writes to those digits. If something
+ * does, call `invalidate()` to rewrite all digits at the next update.
+ *
+ * @tparam T_LED_MODULE the class of the underlying LED Module, often LedModule
+ *    but other classes with the same generic public methods can be substituted
+ * @tparam T_DIGITS number of digits of the LED module if known at compile
+ *    time, which allows the bounds checks and loops to be optimized by the
+ *    compiler; or 0 (default) to use `T_LED_MODULE::size()` at runtime
+ * @tparam T_STORAGE storage policy of the digit patterns of the NumberWriter,
+ *    FlashStorage (default) or RamStorage
+ */
+template <
+    typename T_LED_MODULE,
+    uint8_t T_DIGITS = 0,
+    typename T_STORAGE = FlashStorage>
+class CounterWriter {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param numberWriter instance of
+     *    NumberWriter<T_LED_MODULE, T_DIGITS, T_STORAGE>
+     * @param numDigits number of digits of the counter, truncated to
+     *    `T_DIGITS`, or to 16 if `T_DIGITS` is 0
+     * @param radixes optional array of `numDigits` radixes (2-16), from the
+     *    left-most digit to the right-most digit, which must outlive this
+     *    object; or nullptr (default) for a decimal counter
+     * @param startPos position of the left-most digit of the counter
+     */
+    explicit CounterWriter(
+        NumberWriter<T_LED_MODULE, T_DIGITS, T_STORAGE>& numberWriter,
+        uint8_t numDigits,
+        const uint8_t radixes[] = nullptr,
+        uint8_t startPos = 0
+    ) :
+        mNumberWriter(numberWriter),
+        mRadixes(radixes),
+        mDecimalPoints(0),
+        mNumDigits((numDigits < kBufferSize) ? numDigits : kBufferSize),
+        mStartPos(startPos),
+        mDirtyDigit(0),
+        mDigits()
+    {}
+
+    /** Get the underlying LedModule. */
+    T_LED_MODULE& ledModule() { return mNumberWriter.ledModule(); }
+
+    /** Get the underlying PatternWriter. */
+    PatternWriter<T_LED_MODULE, T_DIGITS>& patternWriter() {
+      return mNumberWriter.patternWriter();
+    }
+
+    /** Get the underlying NumberWriter. */
+    NumberWriter<T_LED_MODULE, T_DIGITS, T_STORAGE>& numberWriter() {
+      return mNumberWriter;
+    }
+
+    /** Return the number of digits of the counter. */
+    uint8_t size() const { return mNumDigits; }
+
+    /** Return the value of the digit at `i`, 0 being the left-most digit. */
+    uint8_t getDigit(uint8_t i) const { return mDigits[i]; }
+
+    /** Return the value of the counter. */
+    uint32_t getValue() const {
+      uint32_t value = 0;
+      for (uint8_t i = 0; i < mNumDigits; i++) {
+        value = value * radix(i) + mDigits[i];
+      }
+      return value;
+    }
+
+    /** Return true if every digit is 0. */
+    bool isZero() const {
+      for (uint8_t i = 0; i < mNumDigits; i++) {
+        if (mDigits[i] != 0) return false;
+      }
+      return true;
+    }
+
+    /**
+     * Set the counter to `value`, modulo the range of the counter, and write
+     * the digits which changed. This is the only method which divides.
+     */
+    void setValue(uint32_t value) {
+      for (uint8_t i = mNumDigits; i-- > 0; ) {
+        uint8_t r = radix(i);
+        uint32_t quotient = value / r;
+        setDigit(i, value - quotient * r);
+        value = quotient;
+      }
+      draw();
+    }
+
+    /**
+     * Add 1 to the counter, and write the digits which changed.
+     *
+     * @return true if the counter overflowed and wrapped around to 0
+     */
+    bool increment() {
+      bool isOverflow = true;
+      for (uint8_t i = mNumDigits; i-- > 0; ) {
+        if (mDigits[i] + 1 < radix(i)) {
+          setDigit(i, mDigits[i] + 1);
+          isOverflow = false;
+          break;
+        }
+        setDigit(i, 0);
+      }
+      draw();
+      return isOverflow;
+    }
+
+    /**
+     * Subtract 1 from the counter, and write the digits which changed.
+     *
+     * @return true if the counter underflowed and wrapped around to its
+     *    maximum value
+     */
+    bool decrement() {
+      bool isUnderflow = true;
+      for (uint8_t i = mNumDigits; i-- > 0; ) {
+        if (mDigits[i] > 0) {
+          setDigit(i, mDigits[i] - 1);
+          isUnderflow = false;
+          break;
+        }
+        setDigit(i, radix(i) - 1);
+      }
+      draw();
+      return isUnderflow;
+    }
+
+    /**
+     * Set the digits of the counter which have a decimal point, bit 0 being
+     * the left-most digit. The change is written at the next update.
+     */
+    void setDecimalPoints(uint16_t decimalPoints) {
+      if (decimalPoints == mDecimalPoints) return;
+      mDecimalPoints = decimalPoints;
+      invalidate();
+    }
+
+    /** Force the next update to rewrite all digits of the counter. */
+    void invalidate() { mDirtyDigit = 0; }
+
+  private:
+    // disable copy-constructor and assignment operator
+    CounterWriter(const CounterWriter&) = delete;
+    CounterWriter& operator=(const CounterWriter&) = delete;
+
+    static_assert(T_DIGITS <= 16, "T_DIGITS must be <= 16");
+
+    /** Maximum number of digits of the counter. */
+    static const uint8_t kBufferSize = T_DIGITS ? T_DIGITS : 16;
+
+    /** Value of mDirtyDigit when no digit needs to be written. */
+    static const uint8_t kNoDirtyDigit = 255;
+
+    /** Return the radix of the digit at `i`. */
+    uint8_t radix(uint8_t i) const { return mRadixes ? mRadixes[i] : 10; }
+
+    /** Set the digit at `i`, and mark it for writing if it changed. */
+    void setDigit(uint8_t i, uint8_t digit) {
+      if (mDigits[i] == digit) return;
+      mDigits[i] = digit;
+      if (i < mDirtyDigit) mDirtyDigit = i;
+    }
+
+    /** Write the digits from mDirtyDigit to the right-most digit. */
+    void draw() {
+      uint8_t start = mDirtyDigit;
+      mDirtyDigit = kNoDirtyDigit;
+      if (start >= mNumDigits) return;
+
+      uint8_t patterns[kBufferSize];
+      for (uint8_t i = start; i < mNumDigits; i++) {
+        uint8_t pattern = T_STORAGE::readPattern(
+            T_STORAGE::digitPatterns() + mDigits[i]);
+        if (mDecimalPoints & (uint16_t) (1 << i)) pattern |= 0x80;
+        patterns[i] = pattern;
+      }
+
+      PatternWriter<T_LED_MODULE, T_DIGITS>& writer = patternWriter();
+      writer.pos(mStartPos + start);
+      writer.writePatterns(patterns + start, mNumDigits - start);
+    }
+
+  private:
+    NumberWriter<T_LED_MODULE, T_DIGITS, T_STORAGE>& mNumberWriter;
+    const uint8_t* const mRadixes;
+
+    /** Bit mask of the digits with a decimal point. */
+    uint16_t mDecimalPoints;
+
+    uint8_t const mNumDigits;
+    uint8_t const mStartPos;
+
+    /** The left-most digit which changed since the last draw. */
+    uint8_t mDirtyDigit;
+
+    /** The value of each digit, the left-most digit first. */
+    uint8_t mDigits[kBufferSize];
+};
+
+}
+
+#endif
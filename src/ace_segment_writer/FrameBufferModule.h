@@ -0,0 +1,179 @@
+/*
+MIT License
+
+Copyright (c) 2023 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_SEGMENT_WRITER_FRAME_BUFFER_MODULE_H
+#define ACE_SEGMENT_WRITER_FRAME_BUFFER_MODULE_H
+
+#include <stdint.h>
+
+namespace ace_segment {
+
+/**
+ * A double-buffered wrapper around a `T_LED_MODULE` which prevents a partially
+ * written frame from being displayed when the LED module is rendered from an
+ * interrupt service routine (ISR).
+ *
+ * The Writer classes write into the *back* buffer through the same public
+ * methods as `LedModule`. When the frame is complete, the main loop calls
+ * `commit()` which swaps the back and front buffers by flipping a single byte,
+ * so it is an O(1) operation that is atomic with respect to the ISR. The ISR
+ * calls `publish()` just before rendering the LED module. It copies the front
+ * buffer into the underlying LED module only if a new frame was committed since
+ * the previous call. The ISR never sees a frame that is still being composed by
+ * the Writer classes, so interrupts do not need to be disabled around the
+ * Writer calls.
+ *
+ * @code{.cpp}
+ * Hc595Module<SpiInterface, 4> ledModule(...);
+ * FrameBufferModule<LedModule, 4> frameBufferModule(ledModule);
+ * PatternWriter<FrameBufferModule<LedModule, 4>> patternWriter(
+ *     frameBufferModule);
+ * ClockWriter<...> clockWriter(...);
+ *
+ * void renderNow() { // ISR
+ *   frameBufferModule.publish();
+ *   ledModule.renderFieldNow();
+ * }
+ *
+ * void loop() {
+ *   clockWriter.home();
+ *   clockWriter.writeHourMinute24(hh, mm);
+ *   frameBufferModule.commit();
+ * }
+ * @endcode
+ *
+ * The swap is safe on single-core microcontrollers, where the main loop cannot
+ * run while the ISR is executing.
+ *
+ * @tparam T_LED_MODULE the class of the underlying LED Module, often LedModule
+ *    but other classes with the same generic public methods can be substituted
+ * @tparam T_DIGITS number of digits in the underlying LED module
+ */
+template <typename T_LED_MODULE, uint8_t T_DIGITS>
+class FrameBufferModule {
+  public:
+    /**
+     * Constructor.
+     * @param ledModule the underlying LED module which receives the committed
+     *    frames
+     */
+    explicit FrameBufferModule(T_LED_MODULE& ledModule) :
+        mLedModule(ledModule),
+        mBuffers(),
+        mFront(0),
+        mIsPending(false)
+    {}
+
+    /** Return the underlying LedModule. */
+    T_LED_MODULE& ledModule() const { return mLedModule; }
+
+    /** Return the number of digits supported by this display instance. */
+    uint8_t size() const { return T_DIGITS; }
+
+    /** Set the pattern at `pos` in the back buffer. */
+    void setPatternAt(uint8_t pos, uint8_t pattern) {
+      mBuffers[mFront ^ 1][pos] = pattern;
+    }
+
+    /** Return the pattern at `pos` in the back buffer. */
+    uint8_t getPatternAt(uint8_t pos) const {
+      return mBuffers[mFront ^ 1][pos];
+    }
+
+    /** Set or clear the decimal point at `pos` in the back buffer. */
+    void setDecimalPointAt(uint8_t pos, bool state = true) {
+      if (pos >= T_DIGITS) return;
+      uint8_t* back = mBuffers[mFront ^ 1];
+      if (state) {
+        back[pos] |= 0x80;
+      } else {
+        back[pos] &= ~0x80;
+      }
+    }
+
+    /** Set the brightness of the underlying LED module. */
+    void setBrightness(uint8_t brightness) {
+      mLedModule.setBrightness(brightness);
+    }
+
+    /** Get the brightness of the underlying LED module. */
+    uint8_t getBrightness() const {
+      return mLedModule.getBrightness();
+    }
+
+    /**
+     * Make the back buffer the new front buffer, to be sent to the LED module
+     * by the next `publish()`. The new back buffer is then initialized with a
+     * copy of the committed frame, so that the Writer classes can continue to
+     * update only the digits that change. Called from the main loop.
+     */
+    void commit() {
+      uint8_t front = mFront ^ 1;
+      mFront = front;
+      mIsPending = true;
+
+      // The ISR reads only the front buffer, so this copy is safe.
+      const uint8_t* src = mBuffers[front];
+      uint8_t* dst = mBuffers[front ^ 1];
+      for (uint8_t i = 0; i < T_DIGITS; ++i) {
+        dst[i] = src[i];
+      }
+    }
+
+    /**
+     * Copy the front buffer into the underlying LED module if a new frame was
+     * committed since the last call. Intended to be called from the ISR just
+     * before rendering the LED module, but can also be called from the main
+     * loop before a `flush()`.
+     *
+     * @return true if a new frame was copied into the LED module
+     */
+    bool publish() {
+      if (! mIsPending) return false;
+      mIsPending = false;
+
+      const uint8_t* front = mBuffers[mFront];
+      for (uint8_t i = 0; i < T_DIGITS; ++i) {
+        mLedModule.setPatternAt(i, front[i]);
+      }
+      return true;
+    }
+
+  private:
+    // disable copy-constructor and assignment operator
+    FrameBufferModule(const FrameBufferModule&) = delete;
+    FrameBufferModule& operator=(const FrameBufferModule&) = delete;
+
+  private:
+    T_LED_MODULE& mLedModule;
+    uint8_t mBuffers[2][T_DIGITS];
+
+    // Modified by the main loop, read by the ISR.
+    volatile uint8_t mFront;
+    volatile bool mIsPending;
+};
+
+} // ace_segment
+
+#endif
@@ -0,0 +1,226 @@
+/*
+MIT License
+
+Copyright (c) 2023 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_SEGMENT_WRITER_FRAME_RECORDER_MODULE_H
+#define ACE_SEGMENT_WRITER_FRAME_RECORDER_MODULE_H
+
+#include <stdint.h>
+#include <Arduino.h> // Print
+#include "PatternWriter.h" // internal::HasSetPatternsAt, internal::EnableIf
+
+namespace ace_segment {
+
+/**
+ * A flight recorder which sits between the Writer classes and a `T_LED_MODULE`,
+ * and keeps the last `T_NUM_FRAMES` frames sent to the LED module, so that the
+ * content of the display can be examined after a problem in the field. All
+ * calls are forwarded to the underlying LED module unchanged.
+ *
+ * The application calls `commit(millis())` after each frame is complete. This
+ * copies the `T_DIGITS` patterns of the LED module (including the decimal
+ * point bits) and the timestamp into a fixed-size ring buffer, overwriting the
+ * oldest frame. The cost of `commit()` is a fixed copy of `T_DIGITS` bytes, and
+ * no memory is allocated on the heap, so the recorder can remain enabled in
+ * production builds. The recorded frames are printed by `dump()`.
+ *
+ * @code{.cpp}
+ * Max7219Module<SpiInterface, 8> ledModule(...);
+ * FrameRecorderModule<LedModule, 8, 16> recorderModule(ledModule);
+ * PatternWriter<FrameRecorderModule<LedModule, 8, 16>> patternWriter(
+ *     recorderModule);
+ * ...
+ *
+ * void loop() {
+ *   numberWriter.home();
+ *   numberWriter.writeSignedDecimal(reading);
+ *   recorderModule.commit(millis());
+ *   ledModule.flush();
+ *
+ *   if (Serial.read() == 'd') recorderModule.dump(Serial);
+ * }
+ * @endcode
+ *
+ * The ring buffer consumes `T_NUM_FRAMES * (T_DIGITS + 4)` bytes of static
+ * RAM.
+ *
+ * @tparam T_LED_MODULE the class of the underlying LED Module, often LedModule
+ *    but other classes with the same generic public methods can be substituted
+ * @tparam T_DIGITS number of digits in the underlying LED module
+ * @tparam T_NUM_FRAMES number of frames retained in the ring buffer
+ */
+template <typename T_LED_MODULE, uint8_t T_DIGITS, uint8_t T_NUM_FRAMES>
+class FrameRecorderModule {
+  static_assert(T_NUM_FRAMES > 0, "T_NUM_FRAMES must be at least 1");
+
+  public:
+    /**
+     * Constructor.
+     * @param ledModule the underlying LED module
+     */
+    explicit FrameRecorderModule(T_LED_MODULE& ledModule) :
+        mLedModule(ledModule),
+        mNext(0),
+        mNumFrames(0)
+    {}
+
+    /** Return the underlying LedModule. */
+    T_LED_MODULE& ledModule() const { return mLedModule; }
+
+    /** Return the number of digits supported by this display instance. */
+    uint8_t size() const { return T_DIGITS; }
+
+    /** Set the pattern at `pos` in the underlying module. */
+    void setPatternAt(uint8_t pos, uint8_t pattern) {
+      mLedModule.setPatternAt(pos, pattern);
+    }
+
+    /**
+     * Set the `len` patterns starting at `pos` in the underlying module. This
+     * method exists only if `T_LED_MODULE` has a `setPatternsAt()`, so that
+     * the Writers do not buffer the patterns for a module which would write
+     * them one digit at a time anyway.
+     */
+    template <typename U = T_LED_MODULE>
+    typename internal::EnableIf<internal::HasSetPatternsAt<U>::value>::type
+    setPatternsAt(uint8_t pos, const uint8_t patterns[], uint8_t len) {
+      mLedModule.setPatternsAt(pos, patterns, len);
+    }
+
+    /** Return the pattern at `pos` of the underlying module. */
+    uint8_t getPatternAt(uint8_t pos) const {
+      return mLedModule.getPatternAt(pos);
+    }
+
+    /** Set or clear the decimal point at `pos` in the underlying module. */
+    void setDecimalPointAt(uint8_t pos, bool state = true) {
+      mLedModule.setDecimalPointAt(pos, state);
+    }
+
+    /** Set the brightness of the underlying module. */
+    void setBrightness(uint8_t brightness) {
+      mLedModule.setBrightness(brightness);
+    }
+
+    /** Get the brightness of the underlying module. */
+    uint8_t getBrightness() const {
+      return mLedModule.getBrightness();
+    }
+
+    /**
+     * Record the current patterns of the LED module as a completed frame,
+     * with the given timestamp. Overwrites the oldest frame when the ring
+     * buffer is full.
+     */
+    void commit(uint32_t nowMillis) {
+      Frame& frame = mFrames[mNext];
+      frame.timeMillis = nowMillis;
+      for (uint8_t i = 0; i < T_DIGITS; ++i) {
+        frame.patterns[i] = mLedModule.getPatternAt(i);
+      }
+
+      mNext = (mNext + 1 < T_NUM_FRAMES) ? mNext + 1 : 0;
+      if (mNumFrames < T_NUM_FRAMES) mNumFrames++;
+    }
+
+    /** Discard all recorded frames. */
+    void clearFrames() {
+      mNext = 0;
+      mNumFrames = 0;
+    }
+
+    /** Return the number of recorded frames, at most T_NUM_FRAMES. */
+    uint8_t numFrames() const { return mNumFrames; }
+
+    /** Return the timestamp of frame `i`, where 0 is the oldest frame. */
+    uint32_t frameMillis(uint8_t i) const {
+      return mFrames[frameIndex(i)].timeMillis;
+    }
+
+    /** Return the pattern at `pos` of frame `i` (0 is the oldest frame). */
+    uint8_t framePatternAt(uint8_t i, uint8_t pos) const {
+      return mFrames[frameIndex(i)].patterns[pos];
+    }
+
+    /**
+     * Print the recorded frames from the oldest to the newest, one frame per
+     * line, as 8 hex digits of the timestamp, a space, then 2 hex digits for
+     * each digit pattern. For example, "0001E240 3F06DB4F" is the frame
+     * "012.3" recorded at 123456 milliseconds.
+     */
+    void dump(Print& printer) const {
+      for (uint8_t i = 0; i < mNumFrames; ++i) {
+        const Frame& frame = mFrames[frameIndex(i)];
+        uint32_t t = frame.timeMillis;
+        printHexByte(printer, t >> 24);
+        printHexByte(printer, t >> 16);
+        printHexByte(printer, t >> 8);
+        printHexByte(printer, t);
+        printer.print(' ');
+        for (uint8_t pos = 0; pos < T_DIGITS; ++pos) {
+          printHexByte(printer, frame.patterns[pos]);
+        }
+        printer.println();
+      }
+    }
+
+  private:
+    // disable copy-constructor and assignment operator
+    FrameRecorderModule(const FrameRecorderModule&) = delete;
+    FrameRecorderModule& operator=(const FrameRecorderModule&) = delete;
+
+    /** A single recorded frame. */
+    struct Frame {
+      uint32_t timeMillis;
+      uint8_t patterns[T_DIGITS];
+    };
+
+    /** Convert the logical frame `i` (0 is oldest) into the ring index. */
+    uint8_t frameIndex(uint8_t i) const {
+      uint16_t index = (uint16_t) mNext + T_NUM_FRAMES - mNumFrames + i;
+      return (index >= T_NUM_FRAMES) ? index - T_NUM_FRAMES : index;
+    }
+
+    static void printHexByte(Print& printer, uint8_t b) {
+      printHexNibble(printer, b >> 4);
+      printHexNibble(printer, b & 0xF);
+    }
+
+    static void printHexNibble(Print& printer, uint8_t n) {
+      printer.print((char) ((n < 10) ? '0' + n : 'A' + n - 10));
+    }
+
+  private:
+    T_LED_MODULE& mLedModule;
+    Frame mFrames[T_NUM_FRAMES];
+
+    /** Index of the slot which receives the next frame. */
+    uint8_t mNext;
+
+    /** Number of valid frames in mFrames. */
+    uint8_t mNumFrames;
+};
+
+} // ace_segment
+
+#endif
@@ -0,0 +1,114 @@
+/*
+MIT License
+
+Copyright (c) 2023 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_SEGMENT_WRITER_FRAME_TICKER_H
+#define ACE_SEGMENT_WRITER_FRAME_TICKER_H
+
+#include <stdint.h>
+
+namespace ace_segment {
+
+/**
+ * A non-blocking timer which converts the current `millis()` into the number
+ * of animation frames which are due, for a configured frame period. The
+ * schedule is kept on a fixed grid of multiples of the frame period, so the
+ * animation speed does not drift when `tick()` is called late. If the loop
+ * fell behind by several periods, `tick()` returns all the frames which are
+ * due at once, so that the caller can skip the intermediate frames and draw
+ * only the last one. If no frame is due, it returns 0 and the caller should
+ * not write anything to the LED module.
+ *
+ * @code{.cpp}
+ * FrameTicker ticker(100);
+ *
+ * void loop() {
+ *   uint16_t numFrames = ticker.tick(millis());
+ *   if (numFrames > 0) {
+ *     frame = (frame + numFrames) % NUM_FRAMES;
+ *     drawFrame(frame);
+ *   }
+ * }
+ * @endcode
+ *
+ * The `uint16_t` millis wraps around every 65.536 seconds, so `tick()` must be
+ * called more often than that.
+ */
+class FrameTicker {
+  public:
+    /**
+     * Constructor.
+     * @param framePeriodMillis duration of each frame in milliseconds
+     */
+    explicit FrameTicker(uint16_t framePeriodMillis = 100) :
+        mFramePeriodMillis(framePeriodMillis),
+        mLastMillis(0),
+        mIsStarted(false)
+    {}
+
+    /** Set the duration of each frame in milliseconds. */
+    void setFramePeriod(uint16_t framePeriodMillis) {
+      mFramePeriodMillis = framePeriodMillis;
+    }
+
+    /** Return the duration of each frame in milliseconds. */
+    uint16_t getFramePeriod() const { return mFramePeriodMillis; }
+
+    /**
+     * Restart the schedule. The next call to `tick()` becomes the start of the
+     * first frame, and the next frame is due one frame period after that.
+     */
+    void reset() { mIsStarted = false; }
+
+    /**
+     * Return the number of frames which became due since the previous call,
+     * usually 0 or 1, but larger if the caller fell behind. A frame period of
+     * 0 makes every call return 1.
+     */
+    uint16_t tick(uint16_t nowMillis) {
+      if (! mIsStarted) {
+        mLastMillis = nowMillis;
+        mIsStarted = true;
+        return 0;
+      }
+      uint16_t elapsed = nowMillis - mLastMillis;
+      if (mFramePeriodMillis == 0) {
+        mLastMillis = nowMillis;
+        return 1;
+      }
+      if (elapsed < mFramePeriodMillis) return 0;
+
+      uint16_t numFrames = elapsed / mFramePeriodMillis;
+      mLastMillis += numFrames * mFramePeriodMillis;
+      return numFrames;
+    }
+
+  private:
+    uint16_t mFramePeriodMillis;
+    uint16_t mLastMillis;
+    bool mIsStarted;
+};
+
+}
+
+#endif
@@ -0,0 +1,286 @@
+/*
+MIT License
+
+Copyright (c) 2023 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_SEGMENT_WRITER_INCREMENTAL_CLOCK_WRITER_H
+#define ACE_SEGMENT_WRITER_INCREMENTAL_CLOCK_WRITER_H
+
+#include <stdint.h>
+#include "PatternWriter.h"
+#include "NumberWriter.h"
+#include "ClockWriter.h"
+
+namespace ace_segment {
+
+/**
+ * A clock which remembers the time on the display, and rewrites only the
+ * digits which changed. The time is set once with `setTime()`, then advanced
+ * by one second with each `tick()`, which increments the minute and second
+ * digits as decimal counters with carry, without any division. The hour is
+ * recalculated only when the minute rolls over.
+ *
+ * The clock is displayed as "hh:mm" on the first 4 digits, or as "hh:mm:ss" on
+ * the first 6 digits if `showSeconds` is true. The colons are the decimal
+ * points at `ClockWriter::getColonDigit()` (and 2 digits to its right for
+ * "hh:mm:ss"). Blinking the colon with `writeColon()` writes only the decimal
+ * points, not the digits.
+ *
+ * @code{.cpp}
+ * ClockWriter<LedModule> clockWriter(numberWriter);
+ * IncrementalClockWriter<LedModule> incrementalClockWriter(clockWriter);
+ *
+ * void setup() {
+ *   ...
+ *   incrementalClockWriter.setTime(12, 34, 56);
+ * }
+ *
+ * void loop() {
+ *   static uint16_t prevMillis;
+ *   static bool isSecond;
+ *
+ *   uint16_t nowMillis = millis();
+ *   if ((uint16_t) (nowMillis - prevMillis) >= 500) {
+ *     prevMillis += 500;
+ *     isSecond = !isSecond;
+ *     if (isSecond) incrementalClockWriter.tick();
+ *     incrementalClockWriter.writeColon(isSecond);
+ *     ledModule.flush();
+ *   }
+ * }
+ * @endcode
+ *
+ * This assumes that nothing else writes to the digits of the clock. If
+ * something does, call `invalidate()` to rewrite all of them at the next
+ * `tick()`, `setTime()` or `writeColon()`.
+ *
+ * @tparam T_LED_MODULE the class of the underlying LED Module, often LedModule
+ *    but other classes with the same generic public methods can be substituted
+ * @tparam T_DIGITS number of digits of the LED module if known at compile
+ *    time, which allows the bounds checks and loops to be optimized by the
+ *    compiler; or 0 (default) to use `T_LED_MODULE::size()` at runtime
+ * @tparam T_STORAGE storage policy of the digit patterns of the NumberWriter,
+ *    FlashStorage (default) or RamStorage
+ */
+template <
+    typename T_LED_MODULE,
+    uint8_t T_DIGITS = 0,
+    typename T_STORAGE = FlashStorage>
+class IncrementalClockWriter {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param clockWriter instance of
+     *    ClockWriter<T_LED_MODULE, T_DIGITS, T_STORAGE>, which provides the
+     *    digit with the colon
+     * @param showSeconds display "hh:mm:ss" on 6 digits instead of "hh:mm"
+     * @param is12Hour display the hour in 12-hour format (1-12, leading space)
+     *    instead of 24-hour format (00-23)
+     */
+    explicit IncrementalClockWriter(
+        ClockWriter<T_LED_MODULE, T_DIGITS, T_STORAGE>& clockWriter,
+        bool showSeconds = false,
+        bool is12Hour = false
+    ) :
+        mClockWriter(clockWriter),
+        mDigits(),
+        mHour(0),
+        mDirtyDigit(0),
+        mShowSeconds(showSeconds),
+        mIs12Hour(is12Hour),
+        mIsColon(true)
+    {}
+
+    /** Get the underlying LedModule. */
+    T_LED_MODULE& ledModule() { return mClockWriter.ledModule(); }
+
+    /** Get the underlying PatternWriter. */
+    PatternWriter<T_LED_MODULE, T_DIGITS>& patternWriter() {
+      return mClockWriter.patternWriter();
+    }
+
+    /** Get the underlying ClockWriter. */
+    ClockWriter<T_LED_MODULE, T_DIGITS, T_STORAGE>& clockWriter() {
+      return mClockWriter;
+    }
+
+    /** Return the hour (0-23). */
+    uint8_t hour() const { return mHour; }
+
+    /** Return the minute (0-59). */
+    uint8_t minute() const { return mDigits[2] * 10 + mDigits[3]; }
+
+    /** Return the second (0-59). */
+    uint8_t second() const { return mDigits[4] * 10 + mDigits[5]; }
+
+    /**
+     * Set the time, and write the digits which differ from the previous
+     * time on the display.
+     *
+     * @param hh hour (0-23)
+     * @param mm minute (0-59)
+     * @param ss second (0-59)
+     */
+    void setTime(uint8_t hh, uint8_t mm, uint8_t ss = 0) {
+      mHour = (hh < 24) ? hh : 0;
+      setHourDigits();
+      setDec2(2, (mm < 60) ? mm : 0);
+      setDec2(4, (ss < 60) ? ss : 0);
+      draw();
+    }
+
+    /**
+     * Advance the clock by one second, and write the digits which changed.
+     * The seconds are counted even if they are not displayed, in which case
+     * nothing is written until the minute changes.
+     */
+    void tick() {
+      uint8_t i = kNumClockDigits - 1;
+      while (true) {
+        uint8_t limit = (i & 1) ? 9 : 5;
+        if (mDigits[i] < limit) {
+          setDigit(i, mDigits[i] + 1);
+          break;
+        }
+        setDigit(i, 0);
+        if (i == 2) {
+          mHour = (mHour < 23) ? mHour + 1 : 0;
+          setHourDigits();
+          break;
+        }
+        i--;
+      }
+      draw();
+    }
+
+    /**
+     * Turn the colon(s) on or off, without rewriting the digits. Does nothing
+     * if the colon(s) are already in that state.
+     */
+    void writeColon(bool state = true) {
+      if (mDirtyDigit < kNoDirtyDigit) {
+        mIsColon = state;
+        draw();
+        return;
+      }
+      if (state == mIsColon) return;
+
+      mIsColon = state;
+      if (mShowSeconds) {
+        mClockWriter.writeColons(state);
+      } else {
+        mClockWriter.writeColon(state);
+      }
+    }
+
+    /**
+     * Force the next `tick()`, `setTime()` or `writeColon()` to rewrite all
+     * digits of the clock, for example after the display was cleared.
+     */
+    void invalidate() { mDirtyDigit = 0; }
+
+  private:
+    // disable copy-constructor and assignment operator
+    IncrementalClockWriter(const IncrementalClockWriter&) = delete;
+    IncrementalClockWriter& operator=(const IncrementalClockWriter&) = delete;
+
+    /** Number of digit counters: hh, mm, ss. */
+    static const uint8_t kNumClockDigits = 6;
+
+    /** Value of mDirtyDigit when no digit needs to be written. */
+    static const uint8_t kNoDirtyDigit = kNumClockDigits;
+
+    /** Decimal point bit of a segment pattern. */
+    static const uint8_t kColonBit = 0x80;
+
+    /** Set the digit at `i`, and mark it for writing if it changed. */
+    void setDigit(uint8_t i, uint8_t digit) {
+      if (mDigits[i] == digit) return;
+      mDigits[i] = digit;
+      if (i < mDirtyDigit) mDirtyDigit = i;
+    }
+
+    /** Set the 2 digits at `i` from the decimal value `d` (0-99). */
+    void setDec2(uint8_t i, uint8_t d) {
+      uint8_t tens = internal::div10(d);
+      setDigit(i, tens);
+      setDigit(i + 1, d - 10 * tens);
+    }
+
+    /** Set the hour digits from mHour. */
+    void setHourDigits() {
+      uint8_t hh = mHour;
+      if (mIs12Hour) {
+        if (hh > 12) hh -= 12;
+        if (hh == 0) hh = 12;
+      }
+      uint8_t tens = internal::div10(hh);
+      uint8_t ones = hh - 10 * tens;
+      if (mIs12Hour && tens == 0) tens = kDigitSpace;
+      setDigit(0, tens);
+      setDigit(1, ones);
+    }
+
+    /** Write the digits from mDirtyDigit to the end of the clock. */
+    void draw() {
+      uint8_t numDigits = mShowSeconds ? kNumClockDigits : 4;
+      uint8_t start = mDirtyDigit;
+      mDirtyDigit = kNoDirtyDigit;
+      if (start >= numDigits) return;
+
+      uint8_t colonDigit = mClockWriter.getColonDigit();
+      uint8_t patterns[kNumClockDigits];
+      for (uint8_t i = start; i < numDigits; i++) {
+        uint8_t pattern = T_STORAGE::readPattern(
+            T_STORAGE::digitPatterns() + mDigits[i]);
+        bool isColonDigit = (i == colonDigit)
+            || (mShowSeconds && i == colonDigit + 2);
+        if (mIsColon && isColonDigit) pattern |= kColonBit;
+        patterns[i] = pattern;
+      }
+
+      PatternWriter<T_LED_MODULE, T_DIGITS>& writer = patternWriter();
+      writer.pos(start);
+      writer.writePatterns(patterns + start, numDigits - start);
+    }
+
+  private:
+    ClockWriter<T_LED_MODULE, T_DIGITS, T_STORAGE>& mClockWriter;
+
+    /** The digits hh, mm, ss, as indexes into the digit patterns. */
+    uint8_t mDigits[kNumClockDigits];
+
+    /** The hour (0-23). */
+    uint8_t mHour;
+
+    /** The left-most digit which changed since the last draw. */
+    uint8_t mDirtyDigit;
+
+    bool const mShowSeconds;
+    bool const mIs12Hour;
+    bool mIsColon;
+};
+
+}
+
+#endif
@@ -43,12 +43,15 @@ const uint8_t kPatternLevelRight = 0b00000110;
  *
  * @tparam T_LED_MODULE the class of the underlying LED Module, often LedModule
  *    but other classes with the same generic public methods can be substituted
+ * @tparam T_DIGITS number of digits of the LED module if known at compile
+ *    time, which allows the bounds checks and loops to be optimized by the
+ *    compiler; or 0 (default) to use `T_LED_MODULE::size()` at runtime
  */
-template <typename T_LED_MODULE>
+template <typename T_LED_MODULE, uint8_t T_DIGITS = 0>
 class LevelWriter {
   public:
     /** Constructor. */
-    explicit LevelWriter(PatternWriter<T_LED_MODULE>& patternWriter) :
+    explicit LevelWriter(PatternWriter<T_LED_MODULE, T_DIGITS>& patternWriter) :
         mPatternWriter(patternWriter)
     {}
 
@@ -56,7 +59,9 @@ class LevelWriter {
     T_LED_MODULE& ledModule() { return mPatternWriter.ledModule(); }
 
     /** Get the underlying PatternWriter. */
-    PatternWriter<T_LED_MODULE>& patternWriter() { return mPatternWriter; }
+    PatternWriter<T_LED_MODULE, T_DIGITS>& patternWriter() {
+      return mPatternWriter;
+    }
 
     /**
      * Return the maximum level supported by this LED display. The range is [0,
@@ -66,19 +71,19 @@ class LevelWriter {
       return mPatternWriter.size() * 2;
     }
 
-    /** Write out the level bar, 2 levels per digit. */
+    /**
+     * Write out the level bar, 2 levels per digit. The full digits, the
+     * partial digit and the blank digits are each written as a single run
+     * through the PatternWriter.
+     */
     void writeLevel(uint8_t level) {
       uint8_t fullDigits = level / 2;
       uint8_t partialDigit = level & 0x1;
-      uint8_t numDigits = mPatternWriter.size();
 
       mPatternWriter.home();
-      for (;;) {
-        uint8_t pos = mPatternWriter.pos();
-        if (pos >= fullDigits || pos >= numDigits) { break; }
-        mPatternWriter.writePattern(kPatternLevelLeft | kPatternLevelRight);
-      }
-      if (partialDigit && mPatternWriter.pos() < numDigits) {
+      mPatternWriter.writeRepeatedPattern(
+          kPatternLevelLeft | kPatternLevelRight, fullDigits);
+      if (partialDigit) {
         mPatternWriter.writePattern(kPatternLevelLeft);
       }
       mPatternWriter.clearToEnd();
@@ -90,7 +95,7 @@ class LevelWriter {
     LevelWriter& operator=(const LevelWriter&) = delete;
 
   private:
-    PatternWriter<T_LED_MODULE>& mPatternWriter;
+    PatternWriter<T_LED_MODULE, T_DIGITS>& mPatternWriter;
 };
 
 }
@@ -0,0 +1,185 @@
+/*
+MIT License
+
+Copyright (c) 2023 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_SEGMENT_WRITER_NUMBER_FILTER_H
+#define ACE_SEGMENT_WRITER_NUMBER_FILTER_H
+
+#include <stdint.h>
+
+namespace ace_segment {
+
+/**
+ * A filter placed in front of a NumberWriter or a TemperatureWriter, which
+ * decides when a noisy reading (e.g. from an ADC) should be written to the
+ * display. The `update()` method returns true only when the displayed value
+ * should change, so that the digits stop flickering and the LED module is not
+ * written on every loop:
+ *
+ * @code{.cpp}
+ * NumberFilter filter(1, 1000);
+ *
+ * void loop() {
+ *   if (filter.update(analogRead(A0), millis())) {
+ *     numberWriter.home();
+ *     numberWriter.writeUnsignedDecimal(filter.value(), 4);
+ *     ledModule.flush();
+ *   }
+ * }
+ * @endcode
+ *
+ * A new reading is first smoothed by an optional exponential moving average
+ * using integer arithmetic: each reading contributes `1/2^smoothingShift` of
+ * the result. The smoothed value is then displayed:
+ *
+ *  * immediately, if it differs from the displayed value by more than the
+ *    `deadband`,
+ *  * otherwise, if it differs at all, when `minIntervalMillis` have elapsed
+ *    since the last change of the display, so that a slow drift is eventually
+ *    shown at a limited rate. A `minIntervalMillis` of 0 holds the displayed
+ *    value until the deadband is exceeded.
+ *
+ * With a deadband of 0, every change is displayed immediately, as if there
+ * were no filter (other than the smoothing).
+ *
+ * The smoothing keeps `value * 2^smoothingShift` in an `int32_t`, so the
+ * readings must fit in `int32_t >> smoothingShift`. The `uint16_t` millis
+ * wraps around every 65.536 seconds, so a value held longer than that may be
+ * displayed up to `minIntervalMillis` later than expected.
+ */
+class NumberFilter {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param deadband changes of the value larger than this are displayed
+     *    immediately
+     * @param minIntervalMillis smaller changes are displayed when this has
+     *    elapsed since the previous change of the display, or never if 0
+     * @param smoothingShift weight of a new reading in the moving average is
+     *    `1/2^smoothingShift`, 0 (default) to disable the smoothing
+     */
+    explicit NumberFilter(
+        uint16_t deadband = 0,
+        uint16_t minIntervalMillis = 0,
+        uint8_t smoothingShift = 0
+    ) :
+        mAccumulator(0),
+        mValue(0),
+        mDeadband(deadband),
+        mMinIntervalMillis(minIntervalMillis),
+        mLastMillis(0),
+        mSmoothingShift(smoothingShift),
+        mIsStarted(false)
+    {}
+
+    /** Set the deadband. */
+    void setDeadband(uint16_t deadband) { mDeadband = deadband; }
+
+    /** Set the minimum interval between changes within the deadband. */
+    void setMinInterval(uint16_t minIntervalMillis) {
+      mMinIntervalMillis = minIntervalMillis;
+    }
+
+    /** Set the smoothing, and restart the filter. */
+    void setSmoothing(uint8_t smoothingShift) {
+      mSmoothingShift = smoothingShift;
+      reset();
+    }
+
+    /**
+     * Restart the filter. The next reading initializes the moving average,
+     * and is displayed unconditionally.
+     */
+    void reset() { mIsStarted = false; }
+
+    /** Return the value to display. */
+    int32_t value() const { return mValue; }
+
+    /**
+     * Add a new `reading` taken at `nowMillis`.
+     *
+     * @return true if the value to display has changed (always true for the
+     *    first reading), which means that the caller should write `value()`
+     *    to the display
+     */
+    bool update(int32_t reading, uint16_t nowMillis) {
+      if (! mIsStarted) {
+        mIsStarted = true;
+        mAccumulator = reading * ((int32_t) 1 << mSmoothingShift);
+        return setValue(reading, nowMillis);
+      }
+
+      int32_t smoothed = smooth(reading);
+      if (smoothed == mValue) return false;
+
+      int32_t delta = smoothed - mValue;
+      if (delta < 0) delta = -delta;
+      if (delta > mDeadband) return setValue(smoothed, nowMillis);
+
+      if (mMinIntervalMillis == 0) return false;
+      if ((uint16_t) (nowMillis - mLastMillis) < mMinIntervalMillis) {
+        return false;
+      }
+      return setValue(smoothed, nowMillis);
+    }
+
+  private:
+    /**
+     * Add `reading` to the moving average, and return the average. The
+     * average is rounded down, the same way as in the feedback term, so that
+     * a constant reading is reached exactly from above and from below.
+     */
+    int32_t smooth(int32_t reading) {
+      if (mSmoothingShift == 0) return reading;
+
+      mAccumulator += reading - (mAccumulator >> mSmoothingShift);
+      return mAccumulator >> mSmoothingShift;
+    }
+
+    bool setValue(int32_t value, uint16_t nowMillis) {
+      mValue = value;
+      mLastMillis = nowMillis;
+      return true;
+    }
+
+  private:
+    /** The moving average, scaled by 2^mSmoothingShift. */
+    int32_t mAccumulator;
+
+    /** The displayed value. */
+    int32_t mValue;
+
+    uint16_t mDeadband;
+    uint16_t mMinIntervalMillis;
+
+    /** The millis when the displayed value last changed. */
+    uint16_t mLastMillis;
+
+    uint8_t mSmoothingShift;
+    bool mIsStarted;
+};
+
+}
+
+#endif
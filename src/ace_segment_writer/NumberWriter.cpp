@@ -28,39 +28,8 @@ SOFTWARE.
 namespace ace_segment {
 
 // Bit patterns for Hex characters (0x00 - 0x0F) plus a few symbols.
-// Adapted from https://github.com/dmadison/LED-Segment-ASCII.
-//
-// 7-segment map:
-//       AAA       000
-//      F   B     5   1
-//      F   B     5   1
-//       GGG       666
-//      E   C     4   2
-//      E   C     4   2
-//       DDD  DP   333  77
-//
-// Segment: DP G F E D C B A
-//    Bits: 7  6 5 4 3 2 1 0
-//
 const uint8_t kDigitPatterns[kNumDigitPatterns] PROGMEM = {
-  0b00111111, /* 0 */
-  0b00000110, /* 1 */
-  0b01011011, /* 2 */
-  0b01001111, /* 3 */
-  0b01100110, /* 4 */
-  0b01101101, /* 5 */
-  0b01111101, /* 6 */
-  0b00000111, /* 7 */
-  0b01111111, /* 8 */
-  0b01101111, /* 9 */
-  0b01110111, /* A */
-  0b01111100, /* b */
-  0b00111001, /* C */
-  0b01011110, /* d */
-  0b01111001, /* E */
-  0b01110001, /* F */
-  0b00000000, /* (space) */
-  0b01000000, /* - */
+#include "DigitPatterns.inc"
 };
 
 } // ace_segment
@@ -26,8 +26,9 @@ SOFTWARE.
 #define ACE_SEGMENT_WRITER_NUMBER_WRITER_H
 
 #include <stdint.h>
-#include <AceCommon.h> // PrintStr<N>
+#include <math.h> // isnan(), isinf()
 #include "PatternWriter.h"
+#include "PatternStorage.h"
 
 namespace ace_segment {
 
@@ -59,6 +60,167 @@ const digit_t kDigitSpace = 16;
 /** The code point in kDigitPatterns[] corresponding to a minus character. */
 const digit_t kDigitMinus = 17;
 
+namespace internal {
+
+/**
+ * Return `n / 10` for all values of `n`, using a multiply and a shift instead
+ * of a division. On 8-bit AVR processors without a hardware divider, a 16-bit
+ * division is a call into libgcc which takes about 200 CPU cycles, but a
+ * 16x16 multiply takes only about 20 cycles.
+ */
+inline uint16_t div10(uint16_t n) {
+  return ((uint32_t) n * 0xCCCD) >> 19;
+}
+
+/** Return `n / 10` for all values of the 8-bit `n` using an 8x8 multiply. */
+inline uint8_t div10(uint8_t n) {
+  return ((uint16_t) n * 205) >> 11;
+}
+
+/**
+ * Return `n / 10` for all values of the 32-bit `n`, using the shift-and-add
+ * algorithm from Hacker's Delight (2nd ed, Figure 10-12). A 32x32 multiply
+ * into a 64-bit product is almost as slow as a division on 8-bit processors,
+ * but shifts and adds of 32-bit integers are cheap.
+ */
+inline uint32_t div10(uint32_t n) {
+  uint32_t q = (n >> 1) + (n >> 2);
+  q += (q >> 4);
+  q += (q >> 8);
+  q += (q >> 16);
+  q >>= 3;
+  uint8_t r = (uint8_t) n - (uint8_t) q * 10;
+  return q + (r > 9);
+}
+
+/**
+ * Return `n / 100` using a multiply and a shift. Valid for `n < 43699`, which
+ * covers the 4-digit range required by NumberWriter::writeDec4().
+ */
+inline uint8_t div100(uint16_t n) {
+  return ((uint32_t) n * 0x147B) >> 19;
+}
+
+/**
+ * Convert the integer num to an array of Digit in the provided buf, with
+ * the least significant digit going to buf[bufSize-1], and then working
+ * backwards to the most significant digit. Shared by all the decimal methods
+ * of NumberWriter.
+ *
+ * @param num number to convert
+ * @param buf buffer of hex characters
+ * @param bufSize must be 5 or larger (largest uint16_t is 65535, plus
+ *    an optional sign bit if called from a signed version)
+ *
+ * @return index into buf that points to the start of the converted number,
+ * e.g. for a single digit number, the returned value will be `bufSize-1`.
+ */
+inline uint8_t toDecimal(uint16_t num, digit_t buf[], uint8_t bufSize) {
+  uint8_t pos = bufSize;
+  while (num >= 10) {
+    uint16_t quot = div10(num);
+    buf[--pos] = (uint8_t) num - (uint8_t) quot * 10;
+    num = quot;
+  }
+  buf[--pos] = num;
+  return pos;
+}
+
+/**
+ * Same as toDecimal() for a 32-bit `num`. The 32-bit division is used only
+ * until the number fits in 16 bits, then the rest of the digits are converted
+ * by the faster toDecimal().
+ *
+ * @param bufSize must be 10 or larger (largest uint32_t is 4294967295), plus
+ *    an optional sign bit if called from a signed version
+ */
+inline uint8_t toDecimal32(uint32_t num, digit_t buf[], uint8_t bufSize) {
+  uint8_t pos = bufSize;
+  while (num > 0xFFFF) {
+    uint32_t quot = div10(num);
+    buf[--pos] = (uint8_t) num - (uint8_t) quot * 10;
+    num = quot;
+  }
+  return toDecimal((uint16_t) num, buf, pos);
+}
+
+/** Return 10^n, for 0 <= n <= 9. */
+inline uint32_t powerOf10(uint8_t n) {
+  uint32_t p = 1;
+  while (n--) p *= 10;
+  return p;
+}
+
+/** Return the number of decimal digits of `num`. */
+inline uint8_t numDecimalDigits(uint32_t num) {
+  uint8_t len = 1;
+  while (num >= 10) {
+    num = div10(num);
+    len++;
+  }
+  return len;
+}
+
+/**
+ * The largest float whose integer part fits in a uint32_t, same as the
+ * overflow limit used by Print::print(double).
+ */
+const float kMaxFixedFloat = 4294967040.0f;
+
+/**
+ * Convert the non-negative float `x` to the digits of its integer part
+ * followed by `prec` digits of its fractional part, rounded to the nearest
+ * last digit, in the same manner as toDecimal(). The fractional part is
+ * extracted with a single multiply by 10^prec instead of the repeated
+ * multiply and subtract of Print::printFloat().
+ *
+ * @param x non-negative number, less than kMaxFixedFloat after rounding
+ * @param prec number of fraction digits, 0-7
+ * @param bufSize must be at least 10 + prec
+ */
+inline uint8_t toFixedDecimal(
+    float x, uint8_t prec, digit_t buf[], uint8_t bufSize) {
+  uint32_t scale = powerOf10(prec);
+  x += 0.5f / scale;
+  uint32_t intPart = (uint32_t) x;
+  uint8_t pos = bufSize;
+  if (prec > 0) {
+    uint32_t fracPart = (uint32_t) ((x - intPart) * scale);
+    if (fracPart >= scale) fracPart = scale - 1;
+    pos = toDecimal32(fracPart, buf, pos);
+    while (bufSize - pos < prec) {
+      buf[--pos] = 0;
+    }
+  }
+  return toDecimal32(intPart, buf, pos);
+}
+
+/**
+ * Normalize the positive float `m` in place to the range [1, 10) such that
+ * the original number is `m * 10^e`, taking into account the rounding to
+ * `prec` fraction digits which can carry into the next decade (e.g. 9.96 with
+ * prec=1 becomes 1.0E1). Returns the exponent `e`.
+ */
+inline int8_t normalizeFloat(float& m, uint8_t prec) {
+  int8_t e = 0;
+  if (m == 0) return e;
+  while (m >= 10) {
+    m /= 10;
+    e++;
+  }
+  while (m < 1) {
+    m *= 10;
+    e--;
+  }
+  if (m + 0.5f / powerOf10(prec) >= 10) {
+    m /= 10;
+    e++;
+  }
+  return e;
+}
+
+} // internal
+
 /**
  * The NumberWriter supports converting decimal and hexadecimal numbers to
  * segment patterns expected by LedModule. The character set includes 0 to F,
@@ -67,12 +229,21 @@ const digit_t kDigitMinus = 17;
  *
  * @tparam T_LED_MODULE the class of the underlying LED Module, often LedModule
  *    but other classes with the same generic public methods can be substituted
+ * @tparam T_DIGITS number of digits of the LED module if known at compile
+ *    time, which allows the bounds checks and loops to be optimized by the
+ *    compiler; or 0 (default) to use `T_LED_MODULE::size()` at runtime
+ * @tparam T_STORAGE storage policy of the digit patterns, FlashStorage
+ *    (default) or RamStorage
  */
-template <typename T_LED_MODULE>
+template <
+    typename T_LED_MODULE,
+    uint8_t T_DIGITS = 0,
+    typename T_STORAGE = FlashStorage>
 class NumberWriter {
   public:
     /** Constructor. */
-    explicit NumberWriter(PatternWriter<T_LED_MODULE>& patternWriter) :
+    explicit NumberWriter(
+        PatternWriter<T_LED_MODULE, T_DIGITS>& patternWriter) :
         mPatternWriter(patternWriter)
     {}
 
@@ -80,7 +251,9 @@ class NumberWriter {
     T_LED_MODULE& ledModule() { return mPatternWriter.ledModule(); }
 
     /** Get the underlying PatternWriter. */
-    PatternWriter<T_LED_MODULE>& patternWriter() { return mPatternWriter; }
+    PatternWriter<T_LED_MODULE, T_DIGITS>& patternWriter() {
+      return mPatternWriter;
+    }
 
     /** Reset cursor to home. */
     void home() { mPatternWriter.home(); }
@@ -115,7 +288,7 @@ class NumberWriter {
         mPatternWriter.writePattern(kPatternSpace);
         mPatternWriter.writePattern(kPatternSpace);
       } else {
-        uint8_t tens = d / 10;
+        uint8_t tens = internal::div10(d);
         uint8_t ones = d - 10 * tens;
         if (tens == 0) {
           mPatternWriter.writePattern(padPattern);
@@ -138,7 +311,7 @@ class NumberWriter {
         mPatternWriter.writePattern(kPatternSpace);
         mPatternWriter.writePattern(kPatternSpace);
       } else {
-        uint8_t high = dd / 100;
+        uint8_t high = internal::div100(dd);
         uint8_t low = dd - high * 100;
         if (high == 0) {
           mPatternWriter.writePattern(padPattern);
@@ -199,7 +372,7 @@ class NumberWriter {
     uint8_t writeUnsignedDecimal(uint16_t num, int8_t boxSize = 0) {
       const uint8_t bufSize = 5;
       digit_t buf[bufSize];
-      uint8_t start = toDecimal(num, buf, bufSize);
+      uint8_t start = internal::toDecimal(num, buf, bufSize);
 
       return writeDigitsInsideBox(&buf[start], bufSize - start, boxSize);
     }
@@ -212,7 +385,35 @@ class NumberWriter {
 
       const uint8_t bufSize = 6;
       digit_t buf[bufSize];
-      uint8_t start = toDecimal(absNum, buf, bufSize);
+      uint8_t start = internal::toDecimal(absNum, buf, bufSize);
+      if (negative) {
+        buf[--start] = kDigitMinus;
+      }
+
+      return writeDigitsInsideBox(&buf[start], bufSize - start, boxSize);
+    }
+
+    /**
+     * Same as writeUnsignedDecimal() for the 32-bit unsigned number `num`,
+     * 0-4294967295. Useful for counters and uptimes on 6 and 8 digit LED
+     * modules, without the flash cost of writeFloat().
+     */
+    uint8_t writeUnsignedDecimal32(uint32_t num, int8_t boxSize = 0) {
+      const uint8_t bufSize = 10;
+      digit_t buf[bufSize];
+      uint8_t start = internal::toDecimal32(num, buf, bufSize);
+
+      return writeDigitsInsideBox(&buf[start], bufSize - start, boxSize);
+    }
+
+    /** Same as writeUnsignedDecimal32() but prepends a '-' sign if negative. */
+    uint8_t writeSignedDecimal32(int32_t num, int8_t boxSize = 0) {
+      bool negative = num < 0;
+      uint32_t absNum = negative ? -(uint32_t) num : num;
+
+      const uint8_t bufSize = 11;
+      digit_t buf[bufSize];
+      uint8_t start = internal::toDecimal32(absNum, buf, bufSize);
       if (negative) {
         buf[--start] = kDigitMinus;
       }
@@ -221,19 +422,174 @@ class NumberWriter {
     }
 
     /**
-     * Write a float using the same format as the Print class. Scientific
-     * notation (e.g. "1.3e8") is not supported, and the largest floating point
-     * number seems to be about 2^32 (but not exactly).
+     * Write the fixed-point number `value / 10^fractionDigits` using integer
+     * arithmetic only. For example, `writeFixed(-1234, 2)` writes "-12.34"
+     * and `writeFixed(5, 2)` writes "0.05". The decimal point is written
+     * using writeDecimalPoint(), so it does not consume a digit. This avoids
+     * the floating point and Print code pulled in by writeFloat().
+     *
+     * @param value the fixed-point value, scaled by 10^fractionDigits
+     * @param fractionDigits number of digits after the decimal point, 0-9.
+     *    If 0, no decimal point is written.
+     * @param boxSize size of the box in digits, same as writeSignedDecimal()
+     *
+     * @return number of digits actually written, not counting the decimal
+     *    point, even if the digits bled over the end of the LED segments
+     */
+    uint8_t writeFixed(int32_t value, uint8_t fractionDigits,
+        int8_t boxSize = 0) {
+      bool negative = value < 0;
+      uint32_t absValue = negative ? -(uint32_t) value : value;
+
+      const uint8_t bufSize = 11;
+      digit_t buf[bufSize];
+      uint8_t start = internal::toDecimal32(absValue, buf, bufSize);
+
+      // Pad with '0' so that there is at least one digit before the decimal
+      // point, leaving room for the minus sign.
+      if (fractionDigits > bufSize - 2) fractionDigits = bufSize - 2;
+      while (bufSize - start <= fractionDigits) {
+        buf[--start] = 0;
+      }
+      if (negative) {
+        buf[--start] = kDigitMinus;
+      }
+
+      return writeDigitsInsideBox(
+          &buf[start], bufSize - start, boxSize, fractionDigits);
+    }
+
+    /**
+     * Write a float using the same format as the Print class, but without
+     * using the Print class. The digit patterns are written directly, without
+     * an intermediate string. Numbers too large for the fixed point notation
+     * (larger than about 2^32) are written using writeFloatExp(), instead of
+     * the "ovf" of the Print class. NaN and infinity are written as 3 spaces.
+     *
+     * @param x floating point number
+     * @param prec number of digits after the decimal point, default 2,
+     *    maximum of 7
+     * @param boxSize size of the box in digits, same as writeSignedDecimal()
+     *
+     * @return number of digits actually written, not counting the decimal
+     *    point
+     */
+    uint8_t writeFloat(float x, uint8_t prec = 2, int8_t boxSize = 0) {
+      if (isnan(x) || isinf(x)) return writeNotANumber(boxSize);
+
+      bool negative = x < 0;
+      float m = negative ? -x : x;
+      if (prec > kMaxFloatPrecision) prec = kMaxFloatPrecision;
+      if (m + 0.5f / internal::powerOf10(prec) >= internal::kMaxFixedFloat) {
+        return writeFloatExp(x, prec, boxSize);
+      }
+
+      const uint8_t bufSize = 11 + kMaxFloatPrecision;
+      digit_t buf[bufSize];
+      uint8_t start = internal::toFixedDecimal(m, prec, buf, bufSize);
+      if (negative) {
+        buf[--start] = kDigitMinus;
+      }
+
+      return writeDigitsInsideBox(&buf[start], bufSize - start, boxSize, prec);
+    }
+
+    /**
+     * Write a float in scientific notation, with one digit before the decimal
+     * point, `prec` digits after the decimal point, followed by an 'E' and the
+     * exponent. For example, 1.3e8 is written as "1.3E8", and -2.5e-7 is
+     * written as "-2.5E-7". NaN and infinity are written as 3 spaces.
      *
      * @param x floating point number
-     * @param prec number of digits after the decimal point, default 2
+     * @param prec number of digits after the decimal point, default 1,
+     *    maximum of 7
+     * @param boxSize size of the box in digits, same as writeSignedDecimal()
+     *
+     * @return number of digits actually written, not counting the decimal
+     *    point
      */
-    void writeFloat(float x, uint8_t prec = 2) {
-      ace_common::PrintStr<16> buf;
-      buf.print(x, prec);
-      for (const char *s = buf.cstr(); *s != '\0'; s++) {
-        writeChar(*s);
+    uint8_t writeFloatExp(float x, uint8_t prec = 1, int8_t boxSize = 0) {
+      if (isnan(x) || isinf(x)) return writeNotANumber(boxSize);
+
+      bool negative = x < 0;
+      float m = negative ? -x : x;
+      if (prec > kMaxFloatPrecision) prec = kMaxFloatPrecision;
+      int8_t e = internal::normalizeFloat(m, prec);
+
+      // Fill from the end: exponent, 'E', mantissa, sign.
+      const uint8_t bufSize = 14 + kMaxFloatPrecision;
+      digit_t buf[bufSize];
+      uint8_t start = internal::toDecimal((uint16_t) (e < 0 ? -e : e),
+          buf, bufSize);
+      if (e < 0) {
+        buf[--start] = kDigitMinus;
+      }
+      buf[--start] = 0xE; // the hex digit 'E'
+      uint8_t expLen = bufSize - start;
+      start = internal::toFixedDecimal(m, prec, buf, start);
+      if (negative) {
+        buf[--start] = kDigitMinus;
       }
+
+      return writeDigitsInsideBox(&buf[start], bufSize - start, boxSize,
+          (prec > 0) ? prec + expLen : 0);
+    }
+
+    /**
+     * Write a float right justified in a box of `boxSize` digits, choosing the
+     * number of digits after the decimal point to fill the box exactly. The
+     * fixed point notation of writeFloat() is used if the integer part fits
+     * and at least one significant digit would be visible, otherwise the
+     * scientific notation of writeFloatExp() is used. For example, with
+     * boxSize=4, 3.14159 is written as "3.142", 123.456 as "123.5", -0.5 as
+     * "-0.50", 123456 as "1.2E5", and 0.00001234 as "1E-5".
+     *
+     * @return number of digits actually written, which can be larger than
+     *    boxSize if even the scientific notation does not fit
+     */
+    uint8_t writeFloatFit(float x, uint8_t boxSize) {
+      if (isnan(x) || isinf(x)) return writeNotANumber(boxSize);
+
+      bool negative = x < 0;
+      float m = negative ? -x : x;
+      uint8_t signLen = negative ? 1 : 0;
+
+      if (m < internal::kMaxFixedFloat) {
+        uint8_t intLen = internal::numDecimalDigits((uint32_t) m);
+        if (signLen + intLen <= boxSize) {
+          uint8_t prec = boxSize - signLen - intLen;
+          if (prec > kMaxFloatPrecision) prec = kMaxFloatPrecision;
+          float rounding = 0.5f / internal::powerOf10(prec);
+          // Rounding can carry into a new integer digit (e.g. 9.96 -> 10.0),
+          // which takes the place of a fraction digit, or overflows the box
+          // if there is none (e.g. 99.99 -> 100).
+          bool carry = internal::numDecimalDigits(
+              (uint32_t) (m + rounding)) > intLen;
+          if (carry && prec > 0) {
+            prec--;
+            rounding *= 10;
+            carry = false;
+          }
+          if (! carry && (m == 0 || m >= rounding)) {
+            return writeFloat(x, prec, boxSize);
+          }
+        }
+      }
+
+      // Mantissa digit, 'E', exponent sign and digits. The rounding at
+      // prec=0 gives the largest possible exponent, so a larger prec can only
+      // shorten the exponent and never overflow the box.
+      float n = m;
+      int8_t e = internal::normalizeFloat(n, 0);
+      int8_t prec = boxSize - signLen - 1 - expLength(e);
+      if (prec < 0) prec = 0;
+      if (prec > kMaxFloatPrecision) prec = kMaxFloatPrecision;
+      n = m;
+      if (prec < kMaxFloatPrecision
+          && expLength(internal::normalizeFloat(n, prec)) < expLength(e)) {
+        prec++;
+      }
+      return writeFloatExp(x, prec, boxSize);
     }
 
     /**
@@ -285,14 +641,44 @@ class NumberWriter {
 
     /** Internal version of writeDigit() without performing bounds check. */
     void write(digit_t c) {
-      uint8_t pattern = pgm_read_byte(&kDigitPatterns[(uint8_t) c]);
+      uint8_t pattern = T_STORAGE::readPattern(
+          T_STORAGE::digitPatterns() + (uint8_t) c);
       mPatternWriter.writePattern(pattern);
     }
 
-    /** Similar to write() without performing bounds check. */
+    /**
+     * Similar to write() without performing bounds check. The patterns are
+     * collected into a small buffer and sent to the PatternWriter using
+     * writePatterns(), so that a led module with a bulk `setPatternsAt()`
+     * receives the whole number in one call.
+     */
     void writeInternalDigits(const digit_t s[], uint8_t len) {
-      for (uint8_t i = 0; i < len; ++i) {
-        write(s[i]);
+      uint8_t patterns[kMaxDigitsPerWrite];
+      while (len > 0) {
+        uint8_t n = (len < kMaxDigitsPerWrite) ? len : kMaxDigitsPerWrite;
+        for (uint8_t i = 0; i < n; ++i) {
+          patterns[i] = T_STORAGE::readPattern(
+              T_STORAGE::digitPatterns() + (uint8_t) s[i]);
+        }
+        mPatternWriter.writePatterns(patterns, n);
+        s += n;
+        len -= n;
+      }
+    }
+
+    /**
+     * Same as writeInternalDigits(), but writes a decimal point before the
+     * last `fractionDigits` digits if `fractionDigits` is not 0.
+     */
+    void writeInternalFixedDigits(
+        const digit_t s[], uint8_t len, uint8_t fractionDigits) {
+      if (fractionDigits == 0) {
+        writeInternalDigits(s, len);
+      } else {
+        uint8_t intLen = len - fractionDigits;
+        writeInternalDigits(s, intLen);
+        writeDecimalPoint();
+        writeInternalDigits(s + intLen, fractionDigits);
       }
     }
 
@@ -302,15 +688,18 @@ class NumberWriter {
      * digits may spill over outside the box.
      *
      * @param boxSize if negative, left justified; if postive, right justified
+     * @param fractionDigits number of trailing digits to write after a
+     *    decimal point, 0 for none
      */
     uint8_t writeDigitsInsideBox(
-        const digit_t s[], uint8_t len, int8_t boxSize) {
+        const digit_t s[], uint8_t len, int8_t boxSize,
+        uint8_t fractionDigits = 0) {
 
       uint8_t absBoxSize = (boxSize < 0) ? -boxSize : boxSize;
 
       // if the box is too small, print normally
       if (len >= absBoxSize) {
-        writeInternalDigits(s, len);
+        writeInternalFixedDigits(s, len, fractionDigits);
         return len;
       }
 
@@ -318,46 +707,41 @@ class NumberWriter {
       uint8_t padSize = absBoxSize - len;
       if (boxSize < 0) {
         // left justified
-        writeInternalDigits(s, len);
-        while (padSize--) write(kDigitSpace);
+        writeInternalFixedDigits(s, len, fractionDigits);
+        mPatternWriter.writeRepeatedPattern(kPatternSpace, padSize);
       } else {
         // right justified
-        while (padSize--) write(kDigitSpace);
-        writeInternalDigits(s, len);
+        mPatternWriter.writeRepeatedPattern(kPatternSpace, padSize);
+        writeInternalFixedDigits(s, len, fractionDigits);
       }
 
       return absBoxSize;
     }
 
-    /**
-     * Convert the integer num to an array of Digit in the provided buf, with
-     * the least significant digit going to buf[bufSize-1], and then working
-     * backwards to the most significant digit.
-     *
-     * @param num number to convert
-     * @param buf buffer of hex characters
-     * @param bufSize must be 5 or larger (largest uint16_t is 65535, plus
-     *    an optional sign bit if called from a signed version)
-     *
-     * @return index into buf that points to the start of the converted number,
-     * e.g. for a single digit number, the returned value will be `bufSize-1`.
-     */
-    static uint8_t toDecimal(uint16_t num, digit_t buf[], uint8_t bufSize) {
-      uint8_t pos = bufSize;
-      while (true) {
-        if (num < 10) {
-          buf[--pos] = num;
-          break;
-        }
-        uint16_t quot = num / 10;
-        buf[--pos] = num - quot * 10;
-        num = quot;
-      }
-      return pos;
+    /** Return the number of digits of 'E' and the exponent `e`. */
+    static uint8_t expLength(int8_t e) {
+      return (e < 0)
+          ? 2 + internal::numDecimalDigits(-e)
+          : 1 + internal::numDecimalDigits(e);
+    }
+
+    /** Write 3 spaces, inside the box, for NaN and infinity. */
+    uint8_t writeNotANumber(int8_t boxSize) {
+      const digit_t spaces[] = {kDigitSpace, kDigitSpace, kDigitSpace};
+      return writeDigitsInsideBox(spaces, 3, boxSize);
     }
 
   private:
-    PatternWriter<T_LED_MODULE> &mPatternWriter;
+    /** Size of the pattern buffer used by writeInternalDigits(). */
+    static const uint8_t kMaxDigitsPerWrite = 8;
+
+    /**
+     * Maximum number of digits after the decimal point of a float. A float
+     * has only about 7 significant decimal digits.
+     */
+    static const uint8_t kMaxFloatPrecision = 7;
+
+    PatternWriter<T_LED_MODULE, T_DIGITS> &mPatternWriter;
 };
 
 }
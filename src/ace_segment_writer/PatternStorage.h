@@ -0,0 +1,134 @@
+/*
+MIT License
+
+Copyright (c) 2023 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_SEGMENT_WRITER_PATTERN_STORAGE_H
+#define ACE_SEGMENT_WRITER_PATTERN_STORAGE_H
+
+#include <stdint.h>
+#include <Arduino.h> // pgm_read_byte()
+
+namespace ace_segment {
+
+// Defined in NumberWriter.cpp.
+extern const uint8_t kDigitPatterns[];
+
+// Defined in CharWriter.cpp.
+extern const uint8_t kPrintableCharPatterns[];
+
+namespace internal {
+
+/**
+ * The kDigitPatterns set and the printable ASCII characters [0x20, 0x7E] of
+ * the default kCharFont, as constexpr arrays which can be evaluated by the
+ * compiler. They are used by ConstPatterns at compile time, and by RamStorage
+ * at runtime. They are built from the same lists (DigitPatterns.inc and
+ * PrintableCharPatterns.inc) as the PROGMEM tables in NumberWriter.cpp and
+ * CharWriter.cpp.
+ *
+ * The arrays are static members of a class template, instead of namespace
+ * scope constexpr arrays which have internal linkage, so that all translation
+ * units of a program share a single copy of each table.
+ */
+template <typename T = void>
+struct ConstPatternTables {
+  /** The 18 patterns of the NumberWriter digits. */
+  static constexpr uint8_t kDigitPatterns[] = {
+#include "DigitPatterns.inc"
+  };
+
+  /** The 95 patterns of the printable ASCII characters. */
+  static constexpr uint8_t kCharPatterns[] = {
+#include "PrintableCharPatterns.inc"
+  };
+};
+
+template <typename T>
+constexpr uint8_t ConstPatternTables<T>::kDigitPatterns[];
+
+template <typename T>
+constexpr uint8_t ConstPatternTables<T>::kCharPatterns[];
+
+} // internal
+
+/**
+ * Storage policy of the NumberWriter and CharWriter classes (and the Writer
+ * classes built on top of them) which reads the digit patterns and the font
+ * from PROGMEM flash memory using `pgm_read_byte()`. This is the default. It
+ * consumes no static RAM, but each lookup is a slower `LPM` instruction on AVR
+ * processors.
+ */
+struct FlashStorage {
+  /** The patterns and the fonts are in PROGMEM. */
+  static const bool kIsProgmem = true;
+
+  /** Read the pattern at address `p`. */
+  static uint8_t readPattern(const uint8_t* p) { return pgm_read_byte(p); }
+
+  /** The 18 patterns of the NumberWriter digits. */
+  static const uint8_t* digitPatterns() { return kDigitPatterns; }
+
+  /** The patterns of the printable ASCII characters of the default font. */
+  static const uint8_t* printableCharPatterns() {
+    return kPrintableCharPatterns;
+  }
+};
+
+/**
+ * Storage policy which reads the digit patterns and the font from ordinary
+ * memory, using the constexpr tables in this file. The lookups are plain array
+ * accesses which the compiler can inline, and fold into constants when the
+ * character is known at compile time.
+ *
+ * On AVR processors, the tables are copied into static RAM at startup: 18
+ * bytes for the NumberWriter digits, and 95 bytes for the CharWriter font,
+ * once per program no matter how many files use this policy. On
+ * 32-bit processors (e.g. ESP8266, ESP32, ARM), the tables remain in flash
+ * memory which is mapped into the address space, so the lookups avoid the
+ * `pgm_read_byte()` indirection without using RAM.
+ *
+ * A CharWriter using this policy supports only its default font, since the
+ * CharFont and kCharPatterns fonts are stored in PROGMEM. Passing them to the
+ * constructor is a compile-time error.
+ */
+struct RamStorage {
+  /** The patterns are in ordinary memory. */
+  static const bool kIsProgmem = false;
+
+  /** Read the pattern at address `p`. */
+  static uint8_t readPattern(const uint8_t* p) { return *p; }
+
+  /** The 18 patterns of the NumberWriter digits. */
+  static const uint8_t* digitPatterns() {
+    return internal::ConstPatternTables<>::kDigitPatterns;
+  }
+
+  /** The patterns of the printable ASCII characters of the default font. */
+  static const uint8_t* printableCharPatterns() {
+    return internal::ConstPatternTables<>::kCharPatterns;
+  }
+};
+
+} // ace_segment
+
+#endif
@@ -26,7 +26,7 @@ SOFTWARE.
 #define ACE_SEGMENT_WRITER_PATTERN_WRITER_H
 
 #include <stdint.h>
-#include <Arduino.h> // pgm_read_byte()
+#include <Arduino.h> // pgm_read_byte(), memcpy_P()
 
 namespace ace_segment {
 
@@ -92,6 +92,79 @@ const uint8_t kPatternDeg = 0b01100011;
 /** The "P" character for "PM". */
 const uint8_t kPatternP = 0b01110011;
 
+namespace internal {
+
+/**
+ * Compile-time detection of whether the `T_LED_MODULE` class provides a range
+ * setter with the signature `setPatternsAt(uint8_t pos, const uint8_t
+ * patterns[], uint8_t len)`. The `value` is `true` if the method exists. This
+ * is implemented with SFINAE instead of `<type_traits>` because the AVR
+ * toolchain does not provide the C++ standard library.
+ */
+template <typename T_LED_MODULE>
+class HasSetPatternsAt {
+  private:
+    typedef char Yes;
+    struct No { char dummy[2]; };
+
+    template <typename U>
+    static Yes probe(decltype(
+        static_cast<U*>(nullptr)->setPatternsAt(
+            (uint8_t) 0, (const uint8_t*) nullptr, (uint8_t) 0),
+        0)*);
+
+    template <typename U>
+    static No probe(...);
+
+  public:
+    static const bool value =
+        sizeof(probe<T_LED_MODULE>(nullptr)) == sizeof(Yes);
+};
+
+/** Tag type used to select an overload based on a compile-time boolean. */
+template <bool B>
+struct BoolTag {};
+
+/**
+ * Defines the member `type` only if `B` is true, to remove a member function
+ * template from the overload set, like `std::enable_if`.
+ */
+template <bool B, typename T = void>
+struct EnableIf {};
+
+template <typename T>
+struct EnableIf<true, T> { typedef T type; };
+
+/** Set the patterns one digit at a time, without setPatternsAt(). */
+template <typename T_LED_MODULE>
+void setModulePatterns(T_LED_MODULE& module, uint8_t pos,
+    const uint8_t patterns[], uint8_t len, BoolTag<false>) {
+  for (uint8_t i = 0; i < len; ++i) {
+    module.setPatternAt(pos++, patterns[i]);
+  }
+}
+
+/** Set the patterns in a single setPatternsAt() call. */
+template <typename T_LED_MODULE>
+void setModulePatterns(T_LED_MODULE& module, uint8_t pos,
+    const uint8_t patterns[], uint8_t len, BoolTag<true>) {
+  module.setPatternsAt(pos, patterns, len);
+}
+
+/**
+ * Set the `len` patterns starting at `pos` of `module`, using its
+ * `setPatternsAt()` if it has one, otherwise its `setPatternAt()`. Used by the
+ * wrapper modules (e.g. ChainedModule) to forward a range write.
+ */
+template <typename T_LED_MODULE>
+void setModulePatterns(T_LED_MODULE& module, uint8_t pos,
+    const uint8_t patterns[], uint8_t len) {
+  setModulePatterns(module, pos, patterns, len,
+      BoolTag<HasSetPatternsAt<T_LED_MODULE>::value>());
+}
+
+} // internal
+
 /**
  * Write LED segment patterns to the underlying LedModule. Other 'Writer'
  * classes provide additional functionality on top of this class (e.g.
@@ -108,8 +181,11 @@ const uint8_t kPatternP = 0b01110011;
  *
  * @tparam T_LED_MODULE the class of the underlying LED Module, often LedModule
  *    but other classes with the same generic public methods can be substituted
+ * @tparam T_DIGITS number of digits of the LED module if known at compile
+ *    time, which allows the bounds checks and loops to be optimized by the
+ *    compiler; or 0 (default) to use `T_LED_MODULE::size()` at runtime
  */
-template <typename T_LED_MODULE>
+template <typename T_LED_MODULE, uint8_t T_DIGITS = 0>
 class PatternWriter {
   public:
     /**
@@ -124,8 +200,11 @@ class PatternWriter {
     /** Return the underlying LedModule. */
     T_LED_MODULE& ledModule() const { return mLedModule; }
 
-    /** Return the number of digits supported by this display instance. */
-    uint8_t size() const { return mLedModule.size(); }
+    /**
+     * Return the number of digits supported by this display instance. This is
+     * a compile-time constant if `T_DIGITS` is non-zero.
+     */
+    uint8_t size() const { return T_DIGITS ? T_DIGITS : mLedModule.size(); }
 
     /** Set the cursor to the beginning. */
     void home() { mPos = 0; }
@@ -138,18 +217,20 @@ class PatternWriter {
 
     /** Write pattern at the current cursor. */
     void writePattern(uint8_t pattern) {
-      if (mPos >= mLedModule.size()) return;
+      if (mPos >= size()) return;
       mLedModule.setPatternAt(mPos, pattern);
       mPos++;
     }
 
-    /** Write the array `patterns[]` of length `len` to the led module. */
+    /**
+     * Write the array `patterns[]` of length `len` to the led module. If the
+     * `T_LED_MODULE` provides a `setPatternsAt(pos, patterns, len)` method, the
+     * patterns are sent to the led module in a single call.
+     */
     void writePatterns(const uint8_t patterns[], uint8_t len) {
-      for (uint8_t i = 0; i < len; i++) {
-        if (mPos >= mLedModule.size()) break;
-        mLedModule.setPatternAt(mPos, patterns[i]);
-        mPos++;
-      }
+      len = clampLength(len);
+      setPatterns(mPos, patterns, len, BulkTag());
+      mPos += len;
     }
 
     /**
@@ -157,12 +238,16 @@ class PatternWriter {
      * The `patterns[]` is stored in PROGMEM flash memory.
      */
     void writePatterns_P(const uint8_t patterns[], uint8_t len) {
-      for (uint8_t i = 0; i < len; i++) {
-        if (mPos >= mLedModule.size()) break;
-        uint8_t pattern = pgm_read_byte(patterns + i);
-        mLedModule.setPatternAt(mPos, pattern);
-        mPos++;
-      }
+      len = clampLength(len);
+      setPatterns_P(mPos, patterns, len, BulkTag());
+      mPos += len;
+    }
+
+    /** Write the same `pattern` `len` times, starting at the current cursor. */
+    void writeRepeatedPattern(uint8_t pattern, uint8_t len) {
+      len = clampLength(len);
+      setRepeatedPattern(mPos, pattern, len, BulkTag());
+      mPos += len;
     }
 
     /**
@@ -173,7 +258,7 @@ class PatternWriter {
      */
     void writeDecimalPoint(bool state = true) {
       if (mPos == 0) return; // cannot write before start
-      if (mPos > mLedModule.size()) return; // cannot write beyond end
+      if (mPos > size()) return; // cannot write beyond end
       mLedModule.setDecimalPointAt(mPos - 1, state);
     }
 
@@ -182,7 +267,7 @@ class PatternWriter {
      * colon segment to one of the decimal points.
      */
     void setDecimalPointAt(uint8_t pos, bool state = true) {
-      if (pos >= mLedModule.size()) return;
+      if (pos >= size()) return;
       mLedModule.setDecimalPointAt(pos, state);
     }
 
@@ -191,9 +276,7 @@ class PatternWriter {
 
     /** Clear the display from `pos` to the end, set the cursor to `home()`. */
     void clearToEnd() {
-      for (uint8_t i = mPos; i < mLedModule.size(); ++i) {
-        mLedModule.setPatternAt(i, 0);
-      }
+      writeRepeatedPattern(0, size());
       home();
     }
 
@@ -202,6 +285,80 @@ class PatternWriter {
     PatternWriter(const PatternWriter&) = delete;
     PatternWriter& operator=(const PatternWriter&) = delete;
 
+    /** Selects the bulk or the per-digit implementations below. */
+    typedef internal::BoolTag<internal::HasSetPatternsAt<T_LED_MODULE>::value>
+        BulkTag;
+
+    /**
+     * Size of the temporary buffer used to convert PROGMEM or repeated
+     * patterns into a RAM array for `setPatternsAt()`.
+     */
+    static const uint8_t kChunkSize = 8;
+
+    /** Return `len` truncated to the number of digits after the cursor. */
+    uint8_t clampLength(uint8_t len) const {
+      uint8_t numDigits = size();
+      if (mPos >= numDigits) return 0;
+      uint8_t remaining = numDigits - mPos;
+      return (len < remaining) ? len : remaining;
+    }
+
+    void setPatterns(uint8_t pos, const uint8_t patterns[], uint8_t len,
+        internal::BoolTag<false>) {
+      for (uint8_t i = 0; i < len; ++i) {
+        mLedModule.setPatternAt(pos++, patterns[i]);
+      }
+    }
+
+    void setPatterns(uint8_t pos, const uint8_t patterns[], uint8_t len,
+        internal::BoolTag<true>) {
+      if (len == 0) return;
+      mLedModule.setPatternsAt(pos, patterns, len);
+    }
+
+    void setPatterns_P(uint8_t pos, const uint8_t patterns[], uint8_t len,
+        internal::BoolTag<false>) {
+      for (uint8_t i = 0; i < len; ++i) {
+        mLedModule.setPatternAt(pos++, pgm_read_byte(patterns + i));
+      }
+    }
+
+    void setPatterns_P(uint8_t pos, const uint8_t patterns[], uint8_t len,
+        internal::BoolTag<true>) {
+      uint8_t buf[kChunkSize];
+      while (len > 0) {
+        uint8_t n = (len < kChunkSize) ? len : kChunkSize;
+        memcpy_P(buf, patterns, n);
+        mLedModule.setPatternsAt(pos, buf, n);
+        patterns += n;
+        pos += n;
+        len -= n;
+      }
+    }
+
+    void setRepeatedPattern(uint8_t pos, uint8_t pattern, uint8_t len,
+        internal::BoolTag<false>) {
+      for (uint8_t i = 0; i < len; ++i) {
+        mLedModule.setPatternAt(pos++, pattern);
+      }
+    }
+
+    void setRepeatedPattern(uint8_t pos, uint8_t pattern, uint8_t len,
+        internal::BoolTag<true>) {
+      if (len == 0) return;
+      uint8_t buf[kChunkSize];
+      uint8_t n = (len < kChunkSize) ? len : kChunkSize;
+      for (uint8_t i = 0; i < n; ++i) {
+        buf[i] = pattern;
+      }
+      while (len > 0) {
+        n = (len < kChunkSize) ? len : kChunkSize;
+        mLedModule.setPatternsAt(pos, buf, n);
+        pos += n;
+        len -= n;
+      }
+    }
+
   private:
     T_LED_MODULE& mLedModule;
     uint8_t mPos;
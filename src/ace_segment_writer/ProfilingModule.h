@@ -0,0 +1,231 @@
+/*
+MIT License
+
+Copyright (c) 2023 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_SEGMENT_WRITER_PROFILING_MODULE_H
+#define ACE_SEGMENT_WRITER_PROFILING_MODULE_H
+
+#include <stdint.h>
+#include "PatternWriter.h" // internal::HasSetPatternsAt, internal::EnableIf
+
+namespace ace_segment {
+
+/**
+ * Counters collected by the ProfilingModule since the last `reset()` or
+ * `snapshot()`.
+ */
+struct ProfilingStats {
+  /** Number of calls to setPatternAt(). */
+  uint16_t numSetPatternAt;
+
+  /** Number of calls to setPatternsAt(). */
+  uint16_t numSetPatternsAt;
+
+  /** Total number of digit patterns written by both of the above. */
+  uint16_t numPatterns;
+
+  /** Number of digit patterns which were identical to the existing pattern. */
+  uint16_t numRedundantPatterns;
+
+  /** Number of calls to setDecimalPointAt(). */
+  uint16_t numSetDecimalPointAt;
+
+  /** Number of decimal points which were already in the requested state. */
+  uint16_t numRedundantDecimalPoints;
+
+  /** Number of calls to setBrightness(). */
+  uint16_t numSetBrightness;
+
+  /** Smallest digit position written, kNoPos if none. */
+  uint8_t minPos;
+
+  /** Largest digit position written, kNoPos if none. */
+  uint8_t maxPos;
+
+  /** Value of `minPos` and `maxPos` when no digit was written. */
+  static const uint8_t kNoPos = 255;
+
+  /** Return true if at least one digit was written. */
+  bool hasWrites() const { return minPos != kNoPos; }
+};
+
+/**
+ * A wrapper around a `T_LED_MODULE` which counts and classifies the calls made
+ * by the Writer classes, to find out which Writer calls generate unnecessary
+ * traffic to the LED module. The number of `setPatternAt()`, `setPatternsAt()`,
+ * `setDecimalPointAt()` and `setBrightness()` calls are counted, as well as the
+ * number of redundant writes which set a digit to the value it already has.
+ * The smallest and largest digit positions written are also recorded.
+ *
+ * The counters can be read at any time with `stats()`. The `snapshot()` method
+ * returns the counters and resets them, so calling it once per frame gives the
+ * traffic and the range of digits touched by each frame.
+ *
+ * @code{.cpp}
+ * Max7219Module<SpiInterface, 8> ledModule(...);
+ * ProfilingModule<LedModule> profilingModule(ledModule);
+ * PatternWriter<ProfilingModule<LedModule>> patternWriter(profilingModule);
+ * ...
+ *
+ * void loop() {
+ *   stringScroller.scrollLeft();
+ *   ProfilingStats stats = profilingModule.snapshot();
+ *   Serial.println(stats.numRedundantPatterns);
+ *   ...
+ * }
+ * @endcode
+ *
+ * The counters are 16 bits and wrap around, so the stats should be read before
+ * 65536 calls accumulate.
+ *
+ * @tparam T_LED_MODULE the class of the underlying LED Module, often LedModule
+ *    but other classes with the same generic public methods can be substituted
+ */
+template <typename T_LED_MODULE>
+class ProfilingModule {
+  public:
+    /**
+     * Constructor.
+     * @param ledModule the underlying LED module
+     */
+    explicit ProfilingModule(T_LED_MODULE& ledModule) :
+        mLedModule(ledModule)
+    {
+      reset();
+    }
+
+    /** Return the underlying LedModule. */
+    T_LED_MODULE& ledModule() const { return mLedModule; }
+
+    /** Return the number of digits of the underlying module. */
+    uint8_t size() const { return mLedModule.size(); }
+
+    /** Set the pattern at `pos` in the underlying module. */
+    void setPatternAt(uint8_t pos, uint8_t pattern) {
+      mStats.numSetPatternAt++;
+      countPattern(pos, pattern);
+      mLedModule.setPatternAt(pos, pattern);
+    }
+
+    /**
+     * Set the `len` patterns starting at `pos` in the underlying module. This
+     * method exists only if `T_LED_MODULE` has a `setPatternsAt()`, so that
+     * the Writers send the same calls to the LED module with or without the
+     * ProfilingModule.
+     */
+    template <typename U = T_LED_MODULE>
+    typename internal::EnableIf<internal::HasSetPatternsAt<U>::value>::type
+    setPatternsAt(uint8_t pos, const uint8_t patterns[], uint8_t len) {
+      mStats.numSetPatternsAt++;
+      for (uint8_t i = 0; i < len; ++i) {
+        countPattern(pos + i, patterns[i]);
+      }
+      mLedModule.setPatternsAt(pos, patterns, len);
+    }
+
+    /** Return the pattern at `pos` of the underlying module. */
+    uint8_t getPatternAt(uint8_t pos) const {
+      return mLedModule.getPatternAt(pos);
+    }
+
+    /** Set or clear the decimal point at `pos` in the underlying module. */
+    void setDecimalPointAt(uint8_t pos, bool state = true) {
+      mStats.numSetDecimalPointAt++;
+      if (pos < size()) {
+        bool current = mLedModule.getPatternAt(pos) & 0x80;
+        if (current == state) mStats.numRedundantDecimalPoints++;
+        updateRange(pos);
+      }
+      mLedModule.setDecimalPointAt(pos, state);
+    }
+
+    /** Set the brightness of the underlying module. */
+    void setBrightness(uint8_t brightness) {
+      mStats.numSetBrightness++;
+      mLedModule.setBrightness(brightness);
+    }
+
+    /** Get the brightness of the underlying module. */
+    uint8_t getBrightness() const {
+      return mLedModule.getBrightness();
+    }
+
+    /** Return the counters collected since the last reset() or snapshot(). */
+    const ProfilingStats& stats() const { return mStats; }
+
+    /** Clear all counters. */
+    void reset() {
+      mStats.numSetPatternAt = 0;
+      mStats.numSetPatternsAt = 0;
+      mStats.numPatterns = 0;
+      mStats.numRedundantPatterns = 0;
+      mStats.numSetDecimalPointAt = 0;
+      mStats.numRedundantDecimalPoints = 0;
+      mStats.numSetBrightness = 0;
+      mStats.minPos = ProfilingStats::kNoPos;
+      mStats.maxPos = ProfilingStats::kNoPos;
+    }
+
+    /**
+     * Return a copy of the counters, then clear them. Calling this at the end
+     * of every frame returns the traffic generated by that frame.
+     */
+    ProfilingStats snapshot() {
+      ProfilingStats stats = mStats;
+      reset();
+      return stats;
+    }
+
+  private:
+    // disable copy-constructor and assignment operator
+    ProfilingModule(const ProfilingModule&) = delete;
+    ProfilingModule& operator=(const ProfilingModule&) = delete;
+
+    void countPattern(uint8_t pos, uint8_t pattern) {
+      mStats.numPatterns++;
+      if (pos >= size()) return;
+      if (mLedModule.getPatternAt(pos) == pattern) {
+        mStats.numRedundantPatterns++;
+      }
+      updateRange(pos);
+    }
+
+    void updateRange(uint8_t pos) {
+      if (mStats.minPos == ProfilingStats::kNoPos) {
+        mStats.minPos = pos;
+        mStats.maxPos = pos;
+      } else if (pos < mStats.minPos) {
+        mStats.minPos = pos;
+      } else if (pos > mStats.maxPos) {
+        mStats.maxPos = pos;
+      }
+    }
+
+  private:
+    T_LED_MODULE& mLedModule;
+    ProfilingStats mStats;
+};
+
+} // ace_segment
+
+#endif
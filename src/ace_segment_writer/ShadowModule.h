@@ -0,0 +1,181 @@
+/*
+MIT License
+
+Copyright (c) 2023 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_SEGMENT_WRITER_SHADOW_MODULE_H
+#define ACE_SEGMENT_WRITER_SHADOW_MODULE_H
+
+#include <stdint.h>
+
+namespace ace_segment {
+
+/**
+ * A wrapper around a `T_LED_MODULE` which keeps a shadow copy of the segment
+ * patterns of each digit, and forwards a `setPatternAt()` or
+ * `setDecimalPointAt()` to the underlying LED module only if the new pattern
+ * is different from the one already displayed. A digit whose pattern has
+ * actually changed is marked as dirty in a bitmask which can be queried using
+ * `isDigitDirty()` and `isAnyDigitDirty()`. The application can use the dirty
+ * bits to decide whether the underlying module needs to be flushed, and reset
+ * them using `clearDigitsDirty()` after the flush.
+ *
+ * This class implements the same public methods as `LedModule`, so it can be
+ * substituted as the `T_LED_MODULE` of any Writer class:
+ *
+ * @code{.cpp}
+ * Tm1637Module<TmiInterface, 4> tm1637Module(...);
+ * ShadowModule<LedModule, 4> shadowModule(tm1637Module);
+ * PatternWriter<ShadowModule<LedModule, 4>> patternWriter(shadowModule);
+ * NumberWriter<ShadowModule<LedModule, 4>> numberWriter(patternWriter);
+ *
+ * void loop() {
+ *   numberWriter.home();
+ *   numberWriter.writeUnsignedDecimal(value, 4);
+ *   if (shadowModule.isAnyDigitDirty()) {
+ *     tm1637Module.flushIncremental();
+ *     shadowModule.clearDigitsDirty();
+ *   }
+ * }
+ * @endcode
+ *
+ * The shadow buffer is initialized to all zeros, which matches the initial
+ * state of the LED modules in the AceSegment library. If the underlying module
+ * is modified directly without going through this class, call `resync()` to
+ * copy its patterns back into the shadow buffer.
+ *
+ * @tparam T_LED_MODULE the class of the underlying LED Module, often LedModule
+ *    but other classes with the same generic public methods can be substituted
+ * @tparam T_DIGITS number of digits in the underlying LED module
+ */
+template <typename T_LED_MODULE, uint8_t T_DIGITS>
+class ShadowModule {
+  public:
+    /**
+     * Constructor.
+     * @param ledModule the underlying LED module which receives the patterns
+     *    that have changed
+     */
+    explicit ShadowModule(T_LED_MODULE& ledModule) :
+        mLedModule(ledModule),
+        mPatterns(),
+        mDirty()
+    {}
+
+    /** Return the underlying LedModule. */
+    T_LED_MODULE& ledModule() const { return mLedModule; }
+
+    /** Return the number of digits supported by this display instance. */
+    uint8_t size() const { return T_DIGITS; }
+
+    /**
+     * Set the pattern at `pos`, forwarding it to the underlying LED module only
+     * if it differs from the current pattern.
+     */
+    void setPatternAt(uint8_t pos, uint8_t pattern) {
+      if (mPatterns[pos] == pattern) return;
+      mPatterns[pos] = pattern;
+      mLedModule.setPatternAt(pos, pattern);
+      setDigitDirty(pos);
+    }
+
+    /** Return the pattern at `pos` from the shadow buffer. */
+    uint8_t getPatternAt(uint8_t pos) const {
+      return mPatterns[pos];
+    }
+
+    /**
+     * Set or clear the decimal point at `pos`, forwarding it to the underlying
+     * LED module only if its state changes.
+     */
+    void setDecimalPointAt(uint8_t pos, bool state = true) {
+      if (pos >= T_DIGITS) return;
+      uint8_t pattern = state
+          ? (mPatterns[pos] | 0x80)
+          : (mPatterns[pos] & ~0x80);
+      if (mPatterns[pos] == pattern) return;
+      mPatterns[pos] = pattern;
+      mLedModule.setDecimalPointAt(pos, state);
+      setDigitDirty(pos);
+    }
+
+    /** Set the brightness of the underlying LED module. */
+    void setBrightness(uint8_t brightness) {
+      mLedModule.setBrightness(brightness);
+    }
+
+    /** Get the brightness of the underlying LED module. */
+    uint8_t getBrightness() const {
+      return mLedModule.getBrightness();
+    }
+
+    /** Return true if the pattern at `pos` has changed since the last clear. */
+    bool isDigitDirty(uint8_t pos) const {
+      return mDirty[pos / 8] & (0x1 << (pos & 0x7));
+    }
+
+    /** Return true if any digit has changed since the last clear. */
+    bool isAnyDigitDirty() const {
+      for (uint8_t i = 0; i < kDirtySize; ++i) {
+        if (mDirty[i]) return true;
+      }
+      return false;
+    }
+
+    /** Clear the dirty bits of all digits. */
+    void clearDigitsDirty() {
+      for (uint8_t i = 0; i < kDirtySize; ++i) {
+        mDirty[i] = 0;
+      }
+    }
+
+    /**
+     * Copy the patterns of the underlying LED module into the shadow buffer.
+     * Needed only if the underlying module was written to directly.
+     */
+    void resync() {
+      for (uint8_t i = 0; i < T_DIGITS; ++i) {
+        mPatterns[i] = mLedModule.getPatternAt(i);
+      }
+    }
+
+  private:
+    // disable copy-constructor and assignment operator
+    ShadowModule(const ShadowModule&) = delete;
+    ShadowModule& operator=(const ShadowModule&) = delete;
+
+    void setDigitDirty(uint8_t pos) {
+      mDirty[pos / 8] |= (0x1 << (pos & 0x7));
+    }
+
+  private:
+    /** Number of bytes needed to hold one dirty bit per digit. */
+    static const uint8_t kDirtySize = (T_DIGITS + 7) / 8;
+
+    T_LED_MODULE& mLedModule;
+    uint8_t mPatterns[T_DIGITS];
+    uint8_t mDirty[kDirtySize];
+};
+
+} // ace_segment
+
+#endif
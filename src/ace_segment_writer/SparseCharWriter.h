@@ -0,0 +1,150 @@
+/*
+MIT License
+
+Copyright (c) 2023 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef ACE_SEGMENT_WRITER_SPARSE_CHAR_WRITER_H
+#define ACE_SEGMENT_WRITER_SPARSE_CHAR_WRITER_H
+
+#include <stdint.h>
+#include <Arduino.h> // pgm_read_byte()
+#include "PatternWriter.h"
+#include "CharWriter.h" // kPatternUnknown
+
+namespace ace_segment {
+
+/**
+ * A sparse font for a small set of symbols which are not contiguous. The
+ * `pairs` array in PROGMEM contains `numChars` pairs of (character, segment
+ * pattern), sorted by character, which are looked up using a binary search.
+ * Characters which are not in the font are displayed as kPatternUnknown.
+ *
+ * @code{.cpp}
+ * const uint8_t SYMBOL_PAIRS[] PROGMEM = {
+ *   '-', 0b01000000,
+ *   'C', 0b00111001,
+ *   'F', 0b01110001,
+ *   'o', 0b01100011, // degree symbol
+ * };
+ * const SparseCharFont SYMBOL_FONT = {SYMBOL_PAIRS, 4};
+ * @endcode
+ */
+struct SparseCharFont {
+  /** Array of `2 * numChars` bytes in PROGMEM, sorted by character. */
+  const uint8_t* pairs;
+
+  /** Number of (character, pattern) pairs. */
+  uint8_t numChars;
+};
+
+/**
+ * A CharWriter for a SparseCharFont. The lookup is a binary search, O(log N),
+ * of the (character, pattern) pairs. This is a separate class, so that the
+ * dense CharWriter used by most applications does not carry the code and the
+ * state of the binary search.
+ *
+ * @tparam T_LED_MODULE the class of the underlying LED Module, often LedModule
+ *    but other classes with the same generic public methods can be substituted
+ * @tparam T_DIGITS number of digits of the LED module if known at compile
+ *    time, which allows the bounds checks and loops to be optimized by the
+ *    compiler; or 0 (default) to use `T_LED_MODULE::size()` at runtime
+ */
+template <typename T_LED_MODULE, uint8_t T_DIGITS = 0>
+class SparseCharWriter {
+  public:
+    /**
+     * Constructor.
+     * @param patternWriter reference to PatternWriter<T_LED_MODULE, T_DIGITS>
+     * @param font the sparse font in PROGMEM
+     */
+    SparseCharWriter(
+        PatternWriter<T_LED_MODULE, T_DIGITS>& patternWriter,
+        const SparseCharFont& font
+    ) :
+        mPatternWriter(patternWriter),
+        mPairs(font.pairs),
+        mNumChars(font.numChars)
+    {}
+
+    /** Get the underlying LedModule. */
+    T_LED_MODULE& ledModule() { return mPatternWriter.ledModule(); }
+
+    /** Get the underlying PatternWriter. */
+    PatternWriter<T_LED_MODULE, T_DIGITS>& patternWriter() {
+      return mPatternWriter;
+    }
+
+    /** Return the number of digits supported by this display instance. */
+    uint8_t size() const { return mPatternWriter.size(); }
+
+    /** Get number of characters in the font. */
+    uint8_t getNumChars() const { return mNumChars; }
+
+    /** Set the cursor to the beginning. */
+    void home() { mPatternWriter.home(); }
+
+    /** Write the character at the specified position. */
+    void writeChar(char c) {
+      mPatternWriter.writePattern(getPattern(c));
+    }
+
+    /**
+     * Get segment pattern for character 'c', using a binary search of the
+     * sorted (character, pattern) pairs.
+     */
+    uint8_t getPattern(char c) const {
+      uint8_t low = 0;
+      uint8_t high = mNumChars;
+      while (low < high) {
+        uint8_t mid = (low + high) / 2;
+        const uint8_t* pair = mPairs + 2 * (uint16_t) mid;
+        uint8_t key = pgm_read_byte(pair);
+        if (key == (uint8_t) c) return pgm_read_byte(pair + 1);
+        if (key < (uint8_t) c) {
+          low = mid + 1;
+        } else {
+          high = mid;
+        }
+      }
+      return kPatternUnknown;
+    }
+
+    /** Clear the entire display. */
+    void clear() { mPatternWriter.clear(); }
+
+    /** Clear the display from `pos` to the end. */
+    void clearToEnd() { mPatternWriter.clearToEnd(); }
+
+  private:
+    // disable copy-constructor and assignment operator
+    SparseCharWriter(const SparseCharWriter&) = delete;
+    SparseCharWriter& operator=(const SparseCharWriter&) = delete;
+
+  private:
+    PatternWriter<T_LED_MODULE, T_DIGITS>& mPatternWriter;
+    const uint8_t* const mPairs;
+    uint8_t const mNumChars;
+};
+
+}
+
+#endif
@@ -26,24 +26,59 @@ SOFTWARE.
 #define ACE_SEGMENT_WRITER_STRING_SCROLLER_H
 
 #include <stdint.h>
-#include <Arduino.h> // pgm_read_byte(), strlen_P()
+#include <Arduino.h> // pgm_read_byte(), strlen_P(), Stream
 #include "StringWriter.h"
+#include "FrameTicker.h"
 
 class __FlashStringHelper;
 
 namespace ace_segment {
 
+/**
+ * A function which returns the next character of a streaming source of text
+ * for StringScroller::initScrollLeft(), or -1 at the end of the text. This
+ * follows the convention of `Stream::read()`.
+ *
+ * @param context the pointer given to StringScroller::initScrollLeft()
+ */
+typedef int (*CharSource)(void* context);
+
 /**
  * Class that scrolls a string left or right.
  *
+ * The segment patterns of the visible window are kept in a ring buffer, so
+ * each scroll step looks up only the single character which enters the
+ * display, rotates the ring buffer by one position, then sends the whole
+ * window to the LED module using PatternWriter::writePatterns(), which uses
+ * the bulk `setPatternsAt()` of the LED module if it exists.
+ *
+ * The text can be a c-string or a flash string of up to 65535 characters, or a
+ * streaming source (a CharSource callback or a `Stream`) of unlimited length
+ * which is read one character per step, so that only the visible window is
+ * kept in memory. A streaming source can be scrolled only to the left.
+ *
+ * If T_DIGITS is 0, the ring buffer holds 16 digits. A wider LED module is
+ * scrolled without the ring buffer: a string is redrawn from the text on every
+ * write, and the patterns of a streaming source are shifted within the LED
+ * module using its `getPatternAt()`.
+ *
  * @tparam T_LED_MODULE the class of the underlying LED Module, often LedModule
  *    but other classes with the same generic public methods can be substituted
+ * @tparam T_DIGITS number of digits of the LED module if known at compile
+ *    time, which allows the bounds checks and loops to be optimized by the
+ *    compiler; or 0 (default) to use `T_LED_MODULE::size()` at runtime
+ * @tparam T_STORAGE storage policy of the font of the CharWriter,
+ *    FlashStorage (default) or RamStorage
  */
-template <typename T_LED_MODULE>
+template <
+    typename T_LED_MODULE,
+    uint8_t T_DIGITS = 0,
+    typename T_STORAGE = FlashStorage>
 class StringScroller {
   public:
     /** Constructor. */
-    explicit StringScroller(CharWriter<T_LED_MODULE>& charWriter) :
+    explicit StringScroller(
+        CharWriter<T_LED_MODULE, T_DIGITS, T_STORAGE>& charWriter) :
         mCharWriter(charWriter)
     {}
 
@@ -51,12 +86,14 @@ class StringScroller {
     T_LED_MODULE& ledModule() { return mCharWriter.ledModule(); }
 
     /** Get the underlying PatternWriter. */
-    PatternWriter<T_LED_MODULE>& patternWriter() {
+    PatternWriter<T_LED_MODULE, T_DIGITS>& patternWriter() {
       return mCharWriter.patternWriter();
     }
 
     /** Get the underlying LedModule. */
-    CharWriter<T_LED_MODULE>& charWriter() { return mCharWriter; }
+    CharWriter<T_LED_MODULE, T_DIGITS, T_STORAGE>& charWriter() {
+      return mCharWriter;
+    }
 
     /** Return the number of digits supported by this display instance. */
     uint8_t size() const { return mCharWriter.size(); }
@@ -64,104 +101,302 @@ class StringScroller {
     /** Set scroll string, clear the display, and prepare to scroll left. */
     void initScrollLeft(const char* s) {
       mString = s;
-      mIsFlashString = false;
+      mSourceType = kSourceString;
       mStringLength = strlen(s);
-      mStringPos = -size(); // start with clear display
-      mCharWriter.clear();
+      mStringPos = -numDigits(); // start with clear display
+      mIsScrollRight = false;
+      clearWindow();
     }
 
     /** Set scroll string, clear the display, and prepare to scroll left. */
     void initScrollLeft(const __FlashStringHelper* fs) {
       mString = fs;
-      mIsFlashString = true;
+      mSourceType = kSourceFlashString;
       mStringLength = strlen_P((const char*) fs);
-      mStringPos = -size(); // start with clear display
-      mCharWriter.clear();
+      mStringPos = -numDigits(); // start with clear display
+      mIsScrollRight = false;
+      clearWindow();
     }
 
     /**
-     * Scroll one position left. Return true when the scrolling is done and the
-     * display is cleared
+     * Set a streaming source of characters, clear the display, and prepare to
+     * scroll left. The `source` is called once per scroll step, until it
+     * returns -1. The length of the text does not need to be known in advance.
+     *
+     * @param source function which returns the next character, or -1
+     * @param context passed to `source`, e.g. a pointer to an object
      */
-    bool scrollLeft() {
-      bool isDone = mStringPos >= mStringLength;
-      if (! isDone) {
-        mStringPos++;
+    void initScrollLeft(CharSource source, void* context) {
+      mSource = source;
+      mString = context;
+      mSourceType = kSourceCallback;
+      mStringPos = -1; // source has not ended
+      mIsScrollRight = false;
+      clearWindow();
+    }
+
+    /**
+     * Set a `Stream` as the streaming source of characters. The scrolling ends
+     * when `Stream::read()` returns -1, so the stream should hold the entire
+     * text (e.g. a file). For a live source like a serial port, use a
+     * CharSource which returns a space while waiting for more characters.
+     */
+    void initScrollLeft(Stream& stream) {
+      initScrollLeft(readStream, &stream);
+    }
+
+    /**
+     * Scroll `numSteps` positions left (default 1), then write the display
+     * once, skipping the intermediate frames. Return true when the scrolling
+     * is done and the display is cleared.
+     */
+    bool scrollLeft(uint16_t numSteps = 1) {
+      bool isDone = false;
+      while (numSteps--) {
+        isDone = shiftLeft();
+        if (isDone) break;
       }
-      writeString();
+      writeWindow();
       return isDone;
     }
 
     /** Set scroll string, clear the display, and prepare to scroll right. */
     void initScrollRight(const char* s) {
       mString = s;
-      mIsFlashString = false;
+      mSourceType = kSourceString;
       mStringLength = strlen(s);
       mStringPos = mStringLength; // start with clear display
-      mCharWriter.clear();
+      mIsScrollRight = true;
+      clearWindow();
     }
 
     /** Set scroll string, clear the display, and prepare to scroll right. */
     void initScrollRight(const __FlashStringHelper* fs) {
       mString = fs;
-      mIsFlashString = true;
+      mSourceType = kSourceFlashString;
       mStringLength = strlen_P((const char*) fs);
       mStringPos = mStringLength; // start with clear display
-      mCharWriter.clear();
+      mIsScrollRight = true;
+      clearWindow();
     }
 
     /**
-     * Scroll one position left. Return true when the scrolling is done and the
-     * display is cleared
+     * Scroll `numSteps` positions right (default 1), then write the display
+     * once, skipping the intermediate frames. Return true when the scrolling
+     * is done and the display is cleared. A streaming source cannot be
+     * scrolled right, and returns true immediately.
      */
-    bool scrollRight() {
-      uint8_t numDigits = size();
-      bool isDone = (mStringPos <= -numDigits);
-      if (! isDone) {
-        mStringPos--;
+    bool scrollRight(uint16_t numSteps = 1) {
+      if (mSourceType == kSourceCallback) return true;
+      bool isDone = false;
+      while (numSteps--) {
+        isDone = shiftRight();
+        if (isDone) break;
       }
-      writeString();
+      writeWindow();
       return isDone;
     }
 
+    /** Set the duration of each scroll step in milliseconds, used by tick(). */
+    void setFramePeriod(uint16_t framePeriodMillis) {
+      mTicker.setFramePeriod(framePeriodMillis);
+    }
+
+    /**
+     * Scroll in the direction given by the last initScrollLeft() or
+     * initScrollRight(), by the number of steps which became due at
+     * `nowMillis` according to the frame period. If the loop fell behind,
+     * the intermediate frames are skipped so that the scrolling speed remains
+     * steady. The first step is due one frame period after the first call
+     * following an init. Nothing is written to the LED module if no step is
+     * due, or if the scrolling is done.
+     *
+     * @return number of steps which were due, 0 if nothing was written
+     */
+    uint16_t tick(uint16_t nowMillis) {
+      uint16_t numSteps = mTicker.tick(nowMillis);
+      if (numSteps == 0 || isDone()) return 0;
+      if (mIsScrollRight) {
+        scrollRight(numSteps);
+      } else {
+        scrollLeft(numSteps);
+      }
+      return numSteps;
+    }
+
+    /** Return true if the scrolling is done and the display is cleared. */
+    bool isDone() const {
+      if (mSourceType == kSourceCallback) {
+        return mStringPos >= numDigits();
+      } else if (mIsScrollRight) {
+        return mStringPos <= -numDigits();
+      } else {
+        return mStringPos >= (int32_t) mStringLength;
+      }
+    }
+
   private:
     // disable copy-constructor and assignment operator
     StringScroller(const StringScroller&) = delete;
     StringScroller& operator=(const StringScroller&) = delete;
 
-    void writeString() {
-      uint8_t numDigits = size();
-      int16_t stringPos = mStringPos;
-      mCharWriter.home();
-      for (uint8_t i = 0; i < numDigits; i++) {
-        char c;
-        if (stringPos < 0 || stringPos >= mStringLength) {
+    /** Number of digits in the scrolling window. */
+    uint8_t numDigits() const { return size(); }
+
+    /**
+     * Return true if the LED module is wider than the ring buffer, so that
+     * the window is not kept in the ring buffer. Always false if T_DIGITS is
+     * not 0.
+     */
+    bool isWide() const { return numDigits() > kBufferSize; }
+
+    /**
+     * Shift the ring buffer one position to the left, without writing to the
+     * LED module. Return true if the scrolling was already done.
+     */
+    bool shiftLeft() {
+      if (isDone()) return true;
+
+      uint8_t n = numDigits();
+      uint8_t pattern;
+      if (mSourceType == kSourceCallback) {
+        // mStringPos counts the steps since the end of the source
+        int c = (mStringPos < 0) ? mSource((void*) mString) : -1;
+        if (c < 0) {
+          mStringPos = (mStringPos < 0) ? 1 : mStringPos + 1;
           c = ' ';
-        } else {
-          // Normally inserting an if-conditional inside a for-loop is not a
-          // good idea. But this is not a speed-critical loop and it loops over
-          // only the number of digits, which will almost always be <= 8. So I
-          // think this is better than creating a duplicate version of this
-          // function using a template function.
-          if (mIsFlashString) {
-            c = pgm_read_byte((const uint8_t*) mString + stringPos);
-          } else {
-            c = *((const char*) mString + stringPos);
-          }
         }
-        mCharWriter.writeChar(c);
-        stringPos++;
+        pattern = mCharWriter.getPattern(c);
+        if (isWide()) {
+          shiftModuleLeft(pattern);
+          return false;
+        }
+      } else {
+        mStringPos++;
+        if (isWide()) return false;
+        pattern = getPatternAt(mStringPos + n - 1);
       }
+
+      // The leftmost digit leaves the window, and its slot in the ring
+      // buffer becomes the rightmost digit.
+      mPatterns[mHead] = pattern;
+      mHead = (mHead + 1 < n) ? mHead + 1 : 0;
+      return false;
+    }
+
+    /**
+     * Shift the ring buffer one position to the right, without writing to the
+     * LED module. Return true if the scrolling was already done.
+     */
+    bool shiftRight() {
+      if (isDone()) return true;
+
+      uint8_t n = numDigits();
+      mStringPos--;
+      if (isWide()) return false;
+
+      // The rightmost digit leaves the window, and its slot in the ring
+      // buffer becomes the leftmost digit.
+      mHead = (mHead > 0) ? mHead - 1 : n - 1;
+      mPatterns[mHead] = getPatternAt(mStringPos);
+      return false;
+    }
+
+    /**
+     * Shift the patterns of a wide LED module one position to the left, and
+     * write `pattern` into the rightmost digit.
+     */
+    void shiftModuleLeft(uint8_t pattern) {
+      T_LED_MODULE& module = ledModule();
+      uint8_t n = numDigits();
+      for (uint8_t i = 1; i < n; i++) {
+        module.setPatternAt(i - 1, module.getPatternAt(i));
+      }
+      module.setPatternAt(n - 1, pattern);
+    }
+
+    /** Return the segment pattern of the character at `stringPos`. */
+    uint8_t getPatternAt(int32_t stringPos) const {
+      char c;
+      if (stringPos < 0 || stringPos >= (int32_t) mStringLength) {
+        c = ' ';
+      } else if (mSourceType == kSourceFlashString) {
+        c = pgm_read_byte((const uint8_t*) mString + stringPos);
+      } else {
+        c = *((const char*) mString + stringPos);
+      }
+      return mCharWriter.getPattern(c);
+    }
+
+    /**
+     * Fill the ring buffer with spaces, clear the display, and restart the
+     * frame schedule of tick().
+     */
+    void clearWindow() {
+      uint8_t space = mCharWriter.getPattern(' ');
+      for (uint8_t i = 0; i < kBufferSize; i++) {
+        mPatterns[i] = space;
+      }
+      mHead = 0;
+      mTicker.reset();
+      mCharWriter.clear();
+    }
+
+    /**
+     * Write the ring buffer to the LED module, starting with the leftmost
+     * digit at mHead, in at most 2 contiguous batches. A wide LED module is
+     * redrawn from the string instead, or was already written by
+     * shiftModuleLeft() for a streaming source.
+     */
+    void writeWindow() {
+      uint8_t n = numDigits();
+      PatternWriter<T_LED_MODULE, T_DIGITS>& writer = patternWriter();
+      if (isWide()) {
+        if (mSourceType == kSourceCallback) return;
+        writer.home();
+        for (uint8_t i = 0; i < n; i++) {
+          writer.writePattern(getPatternAt(mStringPos + i));
+        }
+        return;
+      }
+
+      writer.home();
+      writer.writePatterns(&mPatterns[mHead], n - mHead);
+      if (mHead > 0) {
+        writer.writePatterns(mPatterns, mHead);
+      }
+    }
+
+    /** Adapt Stream::read() to a CharSource. */
+    static int readStream(void* stream) {
+      return static_cast<Stream*>(stream)->read();
     }
 
   private:
+    /** Type of the source of the characters. */
+    static const uint8_t kSourceString = 0;
+    static const uint8_t kSourceFlashString = 1;
+    static const uint8_t kSourceCallback = 2;
+
+    /**
+     * Size of the ring buffer of patterns. If T_DIGITS is 0, the number of
+     * digits is known only at runtime, so the buffer is sized for the common
+     * LED modules, and a wider module is scrolled without it (see isWide()).
+     */
+    static const uint8_t kBufferSize = T_DIGITS ? T_DIGITS : 16;
+
     // The order of these fields is partially motivated to reduce memory
     // consumption on 32-bit processors.
-    CharWriter<T_LED_MODULE>& mCharWriter;
-    const void* mString;
-    int16_t mStringPos; // can become negative
-    uint8_t mStringLength;
-    bool mIsFlashString;
+    CharWriter<T_LED_MODULE, T_DIGITS, T_STORAGE>& mCharWriter;
+    const void* mString; // or the context of mSource
+    CharSource mSource;
+    int32_t mStringPos; // can become negative
+    uint16_t mStringLength;
+    FrameTicker mTicker;
+    uint8_t mSourceType;
+    bool mIsScrollRight;
+    uint8_t mHead; // index of the leftmost digit in mPatterns
+    uint8_t mPatterns[kBufferSize];
 };
 
 } // ace_segment
@@ -40,12 +40,21 @@ namespace ace_segment {
  *
  * @tparam T_LED_MODULE the class of the underlying LED Module, often LedModule
  *    but other classes with the same generic public methods can be substituted
+ * @tparam T_DIGITS number of digits of the LED module if known at compile
+ *    time, which allows the bounds checks and loops to be optimized by the
+ *    compiler; or 0 (default) to use `T_LED_MODULE::size()` at runtime
+ * @tparam T_STORAGE storage policy of the font of the CharWriter,
+ *    FlashStorage (default) or RamStorage
  */
-template <typename T_LED_MODULE>
+template <
+    typename T_LED_MODULE,
+    uint8_t T_DIGITS = 0,
+    typename T_STORAGE = FlashStorage>
 class StringWriter {
   public:
     /** Constructor. */
-    explicit StringWriter(CharWriter<T_LED_MODULE>& charWriter) :
+    explicit StringWriter(
+        CharWriter<T_LED_MODULE, T_DIGITS, T_STORAGE>& charWriter) :
         mCharWriter(charWriter)
     {}
 
@@ -53,12 +62,14 @@ class StringWriter {
     T_LED_MODULE& ledModule() { return mCharWriter.ledModule(); }
 
     /** Get the underlying PatternWriter. */
-    PatternWriter<T_LED_MODULE>& patternWriter() {
+    PatternWriter<T_LED_MODULE, T_DIGITS>& patternWriter() {
       return mCharWriter.patternWriter();
     }
 
     /** Get the underlying CharWriter. */
-    CharWriter<T_LED_MODULE>& charWriter() { return mCharWriter; }
+    CharWriter<T_LED_MODULE, T_DIGITS, T_STORAGE>& charWriter() {
+      return mCharWriter;
+    }
 
     /** Set the cursor to the beginning. */
     void home() { mCharWriter.home(); }
@@ -139,7 +150,7 @@ class StringWriter {
     }
 
   private:
-    CharWriter<T_LED_MODULE>& mCharWriter;
+    CharWriter<T_LED_MODULE, T_DIGITS, T_STORAGE>& mCharWriter;
 };
 
 }
@@ -35,18 +35,34 @@ namespace ace_segment {
  * The TemperatureWriter supports writing integer temperature values in Celcius
  * or Farenheit. Negative values are supported.
  *
+ * Fractional temperatures are written by the `writeTempTenths*()` methods,
+ * which take the temperature in tenths of a degree (e.g. 215 for 21.5) and
+ * write the decimal point using PatternWriter::writeDecimalPoint(), without
+ * any floating point code. See also celsiusToFahrenheitTenths() and
+ * fahrenheitToCelsiusTenths().
+ *
  * @tparam T_LED_MODULE the class of the underlying LED Module, often LedModule
  *    but other classes with the same generic public methods can be substituted
+ * @tparam T_DIGITS number of digits of the LED module if known at compile
+ *    time, which allows the bounds checks and loops to be optimized by the
+ *    compiler; or 0 (default) to use `T_LED_MODULE::size()` at runtime
+ * @tparam T_STORAGE storage policy of the digit patterns of the NumberWriter,
+ *    FlashStorage (default) or RamStorage
  */
-template <typename T_LED_MODULE>
+template <
+    typename T_LED_MODULE,
+    uint8_t T_DIGITS = 0,
+    typename T_STORAGE = FlashStorage>
 class TemperatureWriter {
   public:
     /**
      * Constructor.
      *
-     * @param numberWriter instance of NumberWriter<T_LED_MODULE>
+     * @param numberWriter instance of
+     *    NumberWriter<T_LED_MODULE, T_DIGITS, T_STORAGE>
      */
-    explicit TemperatureWriter(NumberWriter<T_LED_MODULE>& numberWriter) :
+    explicit TemperatureWriter(
+        NumberWriter<T_LED_MODULE, T_DIGITS, T_STORAGE>& numberWriter) :
         mNumberWriter(numberWriter)
     {}
 
@@ -54,12 +70,14 @@ class TemperatureWriter {
     T_LED_MODULE& ledModule() { return mNumberWriter.ledModule(); }
 
     /** Get the underlying PatternWriter. */
-    PatternWriter<T_LED_MODULE>& patternWriter() {
+    PatternWriter<T_LED_MODULE, T_DIGITS>& patternWriter() {
       return mNumberWriter.patternWriter();
     }
 
     /** Get the underlying NumberWriter. */
-    NumberWriter<T_LED_MODULE>& numberWriter() { return mNumberWriter; }
+    NumberWriter<T_LED_MODULE, T_DIGITS, T_STORAGE>& numberWriter() {
+      return mNumberWriter;
+    }
 
     /** Reset cursor to home. */
     void home() { mNumberWriter.home(); }
@@ -110,6 +128,49 @@ class TemperatureWriter {
       return written + 2;
     }
 
+    /**
+     * Write temperature in tenths of a degree without deg or unit, e.g. 215 is
+     * written as "21.5". The decimal point does not consume a digit, so
+     * "-0.5" takes 3 digits of the `boxSize`.
+     *
+     * @return number of digits written, not counting the decimal point
+     */
+    uint8_t writeTempTenths(int16_t tenths, int8_t boxSize = 0) {
+      return mNumberWriter.writeFixed(tenths, 1, boxSize);
+    }
+
+    /** Write temperature in tenths of a degree with degree symbol. */
+    uint8_t writeTempTenthsDeg(int16_t tenths, int8_t boxSize = 0) {
+      uint8_t written = mNumberWriter.writeFixed(
+          tenths, 1, boxSize >= 1 ? boxSize - 1 : 0);
+      patternWriter().writePattern(kPatternDeg);
+      return written + 1;
+    }
+
+    /**
+     * Write temperature in tenths of a degree with degree symbol and 'C'
+     * symbol.
+     */
+    uint8_t writeTempTenthsDegC(int16_t tenths, int8_t boxSize = 0) {
+      uint8_t written = mNumberWriter.writeFixed(
+          tenths, 1, boxSize >= 2 ? boxSize - 2 : 0);
+      patternWriter().writePattern(kPatternDeg);
+      patternWriter().writePattern(kPatternC);
+      return written + 2;
+    }
+
+    /**
+     * Write temperature in tenths of a degree with degree symbol and 'F'
+     * symbol.
+     */
+    uint8_t writeTempTenthsDegF(int16_t tenths, int8_t boxSize = 0) {
+      uint8_t written = mNumberWriter.writeFixed(
+          tenths, 1, boxSize >= 2 ? boxSize - 2 : 0);
+      patternWriter().writePattern(kPatternDeg);
+      patternWriter().writePattern(kPatternF);
+      return written + 2;
+    }
+
     /** Clear the entire display. */
     void clear() { mNumberWriter.clear(); }
 
@@ -121,9 +182,45 @@ class TemperatureWriter {
     TemperatureWriter(const TemperatureWriter&) = delete;
     TemperatureWriter& operator=(const TemperatureWriter&) = delete;
 
-    NumberWriter<T_LED_MODULE>& mNumberWriter;
+    NumberWriter<T_LED_MODULE, T_DIGITS, T_STORAGE>& mNumberWriter;
 };
 
+/**
+ * Convert a Celsius temperature in tenths of a degree to Fahrenheit in tenths
+ * of a degree, using integer arithmetic, rounded to the nearest tenth (halves
+ * away from zero). For example, 215 (21.5C) returns 707 (70.7F). The result
+ * overflows above 1802.6C.
+ *
+ * To convert whole degrees, pass `temp * 10` and round the result with
+ * roundTenths().
+ */
+inline int16_t celsiusToFahrenheitTenths(int16_t tenths) {
+  int32_t n = (int32_t) tenths * 9;
+  return (n + (n >= 0 ? 2 : -2)) / 5 + 320;
+}
+
+/**
+ * Convert a Fahrenheit temperature in tenths of a degree to Celsius in tenths
+ * of a degree, using integer arithmetic, rounded to the nearest tenth (halves
+ * away from zero). For example, 707 (70.7F) returns 215 (21.5C).
+ */
+inline int16_t fahrenheitToCelsiusTenths(int16_t tenths) {
+  int32_t n = ((int32_t) tenths - 320) * 5;
+  return (n + (n >= 0 ? 4 : -4)) / 9;
+}
+
+/**
+ * Round a temperature in tenths of a degree to whole degrees (halves away
+ * from zero). For example, 215 returns 22 and -215 returns -22.
+ */
+inline int16_t roundTenths(int16_t tenths) {
+  int16_t whole = tenths / 10;
+  int8_t remainder = tenths - whole * 10;
+  if (remainder >= 5) return whole + 1;
+  if (remainder <= -5) return whole - 1;
+  return whole;
+}
+
 } // ace_segment
 
 #endif
@@ -29,6 +29,174 @@ TemperatureWriter<LedModule> temperatureWriter(numberWriter);
 CharWriter<LedModule> charWriter(patternWriter);
 StringWriter<LedModule> stringWriter(charWriter);
 
+TestableLedModule<NUM_DIGITS> shadowedLedModule;
+ShadowModule<LedModule, NUM_DIGITS> shadowModule(shadowedLedModule);
+PatternWriter<ShadowModule<LedModule, NUM_DIGITS>> shadowPatternWriter(
+    shadowModule);
+
+TestableLedModule<NUM_DIGITS> frontLedModule;
+typedef FrameBufferModule<LedModule, NUM_DIGITS> TestFrameBufferModule;
+TestFrameBufferModule frameBufferModule(frontLedModule);
+PatternWriter<TestFrameBufferModule> frameBufferWriter(frameBufferModule);
+NumberWriter<TestFrameBufferModule> frameBufferNumberWriter(frameBufferWriter);
+ClockWriter<TestFrameBufferModule> frameBufferClockWriter(
+    frameBufferNumberWriter);
+
+// A LedModule wide enough to hold any 16-bit signed or unsigned number.
+const uint8_t WIDE_NUM_DIGITS = 6;
+TestableLedModule<WIDE_NUM_DIGITS> wideLedModule;
+PatternWriter<LedModule> widePatternWriter(wideLedModule);
+NumberWriter<LedModule> wideNumberWriter(widePatternWriter);
+ClockWriter<LedModule> wideClockWriter(wideNumberWriter);
+
+// A 6-digit LED module whose writes are counted by a ProfilingModule.
+TestableLedModule<WIDE_NUM_DIGITS> wideProfiledLedModule;
+ProfilingModule<LedModule> wideProfilingModule(wideProfiledLedModule);
+typedef ProfilingModule<LedModule> WideProfiledModule;
+PatternWriter<WideProfiledModule> wideProfiledWriter(wideProfilingModule);
+NumberWriter<WideProfiledModule> wideProfiledNumberWriter(wideProfiledWriter);
+ClockWriter<WideProfiledModule> secondsClockWriter(wideProfiledNumberWriter);
+IncrementalClockWriter<WideProfiledModule> secondsClock(
+    secondsClockWriter, true /*showSeconds*/);
+IncrementalClockWriter<WideProfiledModule> minutesClock(
+    secondsClockWriter, false /*showSeconds*/, true /*is12Hour*/);
+
+// A 4-digit decimal counter, and a "m:ss.h" stopwatch at digit 1.
+const uint8_t STOPWATCH_RADIXES[] = {10, 6, 10, 10};
+CounterWriter<WideProfiledModule> counterWriter(wideProfiledNumberWriter, 4);
+CounterWriter<WideProfiledModule> stopwatchWriter(
+    wideProfiledNumberWriter, 4, STOPWATCH_RADIXES, 1 /*startPos*/);
+
+// Two cached fields, and a cached temperature.
+CachedNumberWriter<WideProfiledModule> leftField(wideProfiledNumberWriter);
+CachedNumberWriter<WideProfiledModule> rightField(wideProfiledNumberWriter);
+TemperatureWriter<WideProfiledModule> wideProfiledTemperatureWriter(
+    wideProfiledNumberWriter);
+CachedTemperatureWriter<WideProfiledModule> temperatureField(
+    wideProfiledTemperatureWriter);
+
+// A LedModule which also implements the optional bulk setPatternsAt() method,
+// and counts the number of calls made through each path.
+class BulkLedModule : public TestableLedModule<NUM_DIGITS> {
+  public:
+    void setPatternAt(uint8_t pos, uint8_t pattern) {
+      TestableLedModule<NUM_DIGITS>::setPatternAt(pos, pattern);
+      numSingleCalls++;
+    }
+
+    void setPatternsAt(uint8_t pos, const uint8_t patterns[], uint8_t len) {
+      for (uint8_t i = 0; i < len; i++) {
+        TestableLedModule<NUM_DIGITS>::setPatternAt(pos + i, patterns[i]);
+      }
+      numBulkCalls++;
+    }
+
+    void flush() { numFlushes++; }
+
+    void resetCounts() {
+      numSingleCalls = 0;
+      numBulkCalls = 0;
+      numFlushes = 0;
+    }
+
+    uint8_t numSingleCalls = 0;
+    uint8_t numBulkCalls = 0;
+    uint8_t numFlushes = 0;
+};
+
+// Writers which read the digit patterns and font from ordinary memory.
+TestableLedModule<NUM_DIGITS> ramLedModule;
+PatternWriter<LedModule> ramPatternWriter(ramLedModule);
+NumberWriter<LedModule, 0, RamStorage> ramNumberWriter(ramPatternWriter);
+ClockWriter<LedModule, 0, RamStorage> ramClockWriter(ramNumberWriter);
+CharWriter<LedModule, 0, RamStorage> ramCharWriter(ramPatternWriter);
+StringWriter<LedModule, 0, RamStorage> ramStringWriter(ramCharWriter);
+
+// Writers with a compile-time number of digits.
+TestableLedModule<NUM_DIGITS> fixedLedModule;
+PatternWriter<LedModule, NUM_DIGITS> fixedPatternWriter(fixedLedModule);
+NumberWriter<LedModule, NUM_DIGITS> fixedNumberWriter(fixedPatternWriter);
+CharWriter<LedModule, NUM_DIGITS> fixedCharWriter(fixedPatternWriter);
+StringWriter<LedModule, NUM_DIGITS> fixedStringWriter(fixedCharWriter);
+
+BulkLedModule bulkLedModule;
+PatternWriter<BulkLedModule> bulkPatternWriter(bulkLedModule);
+NumberWriter<BulkLedModule> bulkNumberWriter(bulkPatternWriter);
+LevelWriter<BulkLedModule> bulkLevelWriter(bulkPatternWriter);
+CharWriter<BulkLedModule> bulkCharWriter(bulkPatternWriter);
+StringScroller<BulkLedModule> bulkStringScroller(bulkCharWriter);
+
+StringScroller<LedModule> stringScroller(charWriter);
+AnimationPlayer<BulkLedModule> animationPlayer(bulkPatternWriter);
+CompressedAnimationPlayer<BulkLedModule> compressedPlayer(bulkPatternWriter);
+
+// A LED module wider than the 16-digit ring buffer of the StringScroller.
+const uint8_t EXTRA_WIDE_NUM_DIGITS = 20;
+TestableLedModule<EXTRA_WIDE_NUM_DIGITS> extraWideLedModule;
+PatternWriter<LedModule> extraWidePatternWriter(extraWideLedModule);
+CharWriter<LedModule> extraWideCharWriter(extraWidePatternWriter);
+StringScroller<LedModule> extraWideStringScroller(extraWideCharWriter);
+
+// Two 4-digit modules chained into one 8-digit display.
+BulkLedModule leftBulkModule;
+BulkLedModule rightBulkModule;
+typedef ChainedModule<BulkLedModule, NUM_DIGITS, 2> TestChainedModule;
+TestChainedModule chainedModule({&leftBulkModule, &rightBulkModule});
+PatternWriter<TestChainedModule> chainedPatternWriter(chainedModule);
+NumberWriter<TestChainedModule> chainedNumberWriter(chainedPatternWriter);
+CharWriter<TestChainedModule> chainedCharWriter(chainedPatternWriter);
+StringWriter<TestChainedModule> chainedStringWriter(chainedCharWriter);
+
+// Modules without setPatternsAt().
+TestableLedModule<NUM_DIGITS> leftLedModule;
+TestableLedModule<NUM_DIGITS> rightLedModule;
+typedef ChainedModule<LedModule, NUM_DIGITS, 2> TestSimpleChainedModule;
+TestSimpleChainedModule simpleChainedModule({&leftLedModule, &rightLedModule});
+PatternWriter<TestSimpleChainedModule> simpleChainedWriter(simpleChainedModule);
+
+// Three 6-digit modules chained into an 18-digit display, scrolled with a
+// compile-time and a runtime number of digits.
+TestableLedModule<WIDE_NUM_DIGITS> chainLedModule0;
+TestableLedModule<WIDE_NUM_DIGITS> chainLedModule1;
+TestableLedModule<WIDE_NUM_DIGITS> chainLedModule2;
+typedef ChainedModule<LedModule, WIDE_NUM_DIGITS, 3> TestLongChainedModule;
+const uint8_t LONG_CHAIN_NUM_DIGITS = TestLongChainedModule::kNumDigits;
+TestLongChainedModule longChainedModule(
+    {&chainLedModule0, &chainLedModule1, &chainLedModule2});
+PatternWriter<TestLongChainedModule, LONG_CHAIN_NUM_DIGITS>
+    longChainedWriter(longChainedModule);
+CharWriter<TestLongChainedModule, LONG_CHAIN_NUM_DIGITS>
+    longChainedCharWriter(longChainedWriter);
+StringScroller<TestLongChainedModule, LONG_CHAIN_NUM_DIGITS>
+    longChainedScroller(longChainedCharWriter);
+PatternWriter<TestLongChainedModule> runtimeChainedWriter(longChainedModule);
+CharWriter<TestLongChainedModule> runtimeChainedCharWriter(
+    runtimeChainedWriter);
+StringScroller<TestLongChainedModule> runtimeChainedScroller(
+    runtimeChainedCharWriter);
+
+// Two 4-digit modules showing the same content.
+BulkLedModule frontBulkModule;
+BulkLedModule rearBulkModule;
+typedef BroadcastModule<BulkLedModule, NUM_DIGITS, 2> TestBroadcastModule;
+TestBroadcastModule broadcastModule({&frontBulkModule, &rearBulkModule});
+PatternWriter<TestBroadcastModule> broadcastPatternWriter(broadcastModule);
+NumberWriter<TestBroadcastModule> broadcastNumberWriter(broadcastPatternWriter);
+
+TestableLedModule<NUM_DIGITS> profiledLedModule;
+ProfilingModule<LedModule> profilingModule(profiledLedModule);
+PatternWriter<ProfilingModule<LedModule>> profilingPatternWriter(
+    profilingModule);
+NumberWriter<ProfilingModule<LedModule>> profilingNumberWriter(
+    profilingPatternWriter);
+
+TestableLedModule<NUM_DIGITS> recordedLedModule;
+typedef FrameRecorderModule<LedModule, NUM_DIGITS, 3> TestFrameRecorderModule;
+TestFrameRecorderModule recorderModule(recordedLedModule);
+PatternWriter<TestFrameRecorderModule> recorderPatternWriter(recorderModule);
+NumberWriter<TestFrameRecorderModule> recorderNumberWriter(
+    recorderPatternWriter);
+
 // ----------------------------------------------------------------------
 // Tests for PatternWriter.
 // ----------------------------------------------------------------------
@@ -56,6 +224,558 @@ testF(PatternWriterTest, pos) {
   assertEqual(kPattern0, mPatterns[2]);
 }
 
+// ----------------------------------------------------------------------
+// Tests for the bulk setPatternsAt() path of PatternWriter.
+// ----------------------------------------------------------------------
+
+const uint8_t BULK_PATTERNS[] PROGMEM = {
+  kPattern1, kPattern2, kPattern3, kPattern4, kPattern5
+};
+
+class BulkPatternWriterTest : public TestOnce {
+  protected:
+    void setup() override {
+      bulkPatternWriter.clear();
+      bulkLedModule.resetCounts();
+      mPatterns = bulkLedModule.getPatterns();
+    }
+
+    uint8_t* mPatterns;
+};
+
+testF(BulkPatternWriterTest, hasSetPatternsAt) {
+  assertTrue(internal::HasSetPatternsAt<BulkLedModule>::value);
+  assertFalse(internal::HasSetPatternsAt<LedModule>::value);
+}
+
+testF(BulkPatternWriterTest, writePatterns) {
+  const uint8_t patterns[] = {kPattern1, kPattern2, kPattern3};
+  bulkPatternWriter.pos(1);
+  bulkPatternWriter.writePatterns(patterns, 3);
+  assertEqual(1, bulkLedModule.numBulkCalls);
+  assertEqual(0, bulkLedModule.numSingleCalls);
+  assertEqual(kPattern1, mPatterns[1]);
+  assertEqual(kPattern3, mPatterns[3]);
+  assertEqual(4, bulkPatternWriter.pos());
+}
+
+testF(BulkPatternWriterTest, writePatterns_P_truncated_at_end) {
+  mPatterns[4] = 0;  // TestableLedModule allocates an extra byte to test this
+  bulkPatternWriter.writePatterns_P(BULK_PATTERNS, 5);
+  assertEqual(1, bulkLedModule.numBulkCalls);
+  assertEqual(kPattern1, mPatterns[0]);
+  assertEqual(kPattern4, mPatterns[3]);
+  assertEqual(0, mPatterns[4]);
+
+  // Nothing is written past the end.
+  bulkPatternWriter.writePatterns_P(BULK_PATTERNS, 5);
+  assertEqual(1, bulkLedModule.numBulkCalls);
+}
+
+testF(BulkPatternWriterTest, clearToEnd) {
+  bulkPatternWriter.writePattern(kPattern1);
+  bulkPatternWriter.writePattern(kPattern2);
+  bulkLedModule.resetCounts();
+  bulkPatternWriter.pos(1);
+  bulkPatternWriter.clearToEnd();
+  assertEqual(1, bulkLedModule.numBulkCalls);
+  assertEqual(kPattern1, mPatterns[0]);
+  assertEqual(0, mPatterns[1]);
+}
+
+testF(BulkPatternWriterTest, writeUnsignedDecimal_boxed) {
+  bulkNumberWriter.writeUnsignedDecimal(12, 4);
+  assertEqual(2, bulkLedModule.numBulkCalls);
+  assertEqual(0, bulkLedModule.numSingleCalls);
+  assertEqual(kPatternSpace, mPatterns[0]);
+  assertEqual(kPatternSpace, mPatterns[1]);
+  assertEqual(kPattern1, mPatterns[2]);
+  assertEqual(kPattern2, mPatterns[3]);
+}
+
+testF(BulkPatternWriterTest, writeLevel) {
+  bulkLevelWriter.writeLevel(3);
+  assertEqual(kPatternLevelLeft | kPatternLevelRight, mPatterns[0]);
+  assertEqual(kPatternLevelLeft, mPatterns[1]);
+  assertEqual(0, mPatterns[2]);
+  assertEqual(0, mPatterns[3]);
+  assertEqual(2, bulkLedModule.numBulkCalls);
+  assertEqual(1, bulkLedModule.numSingleCalls);
+}
+
+// ----------------------------------------------------------------------
+// Tests for Writers with a compile-time T_DIGITS.
+// ----------------------------------------------------------------------
+
+class FixedDigitsTest : public TestOnce {
+  protected:
+    void setup() override {
+      fixedPatternWriter.clear();
+      mPatterns = fixedLedModule.getPatterns();
+    }
+
+    uint8_t* mPatterns;
+};
+
+testF(FixedDigitsTest, size) {
+  assertEqual(NUM_DIGITS, fixedPatternWriter.size());
+  assertEqual(NUM_DIGITS, fixedCharWriter.size());
+}
+
+testF(FixedDigitsTest, writeSignedDecimal_outOfBounds_writes_nothing) {
+  mPatterns[4] = 0;  // TestableLedModule allocates an extra byte to test this
+  uint8_t written = fixedNumberWriter.writeSignedDecimal(-1234);
+  assertEqual(5, written);
+  assertEqual(kPatternMinus, mPatterns[0]);
+  assertEqual(kPattern3, mPatterns[3]);
+  assertEqual(0, mPatterns[4]);
+}
+
+testF(FixedDigitsTest, writeString) {
+  uint8_t written = fixedStringWriter.writeString("1.2345");
+  assertEqual(4, written);
+  assertEqual(kPattern1 | 0x80, mPatterns[0]);
+  assertEqual(kPattern4, mPatterns[3]);
+}
+
+// ----------------------------------------------------------------------
+// Tests for ShadowModule.
+// ----------------------------------------------------------------------
+
+class ShadowModuleTest : public TestOnce {
+  protected:
+    void setup() override {
+      shadowPatternWriter.clear();
+      shadowModule.clearDigitsDirty();
+      mPatterns = shadowedLedModule.getPatterns();
+    }
+
+    uint8_t* mPatterns;
+};
+
+testF(ShadowModuleTest, writePattern_marks_changed_digits_dirty) {
+  assertFalse(shadowModule.isAnyDigitDirty());
+
+  shadowPatternWriter.pos(1);
+  shadowPatternWriter.writePattern(kPattern1);
+  assertEqual(kPattern1, mPatterns[1]);
+  assertFalse(shadowModule.isDigitDirty(0));
+  assertTrue(shadowModule.isDigitDirty(1));
+  assertTrue(shadowModule.isAnyDigitDirty());
+}
+
+testF(ShadowModuleTest, writePattern_same_pattern_is_elided) {
+  shadowPatternWriter.writePattern(kPattern2);
+  shadowModule.clearDigitsDirty();
+
+  // Corrupt the underlying module to detect whether the write was forwarded.
+  mPatterns[0] = 0;
+  shadowPatternWriter.home();
+  shadowPatternWriter.writePattern(kPattern2);
+  assertEqual(0, mPatterns[0]);
+  assertFalse(shadowModule.isAnyDigitDirty());
+
+  // clearToEnd() of an already blank display forwards nothing.
+  shadowPatternWriter.clear();
+  assertFalse(shadowModule.isDigitDirty(1));
+  assertTrue(shadowModule.isDigitDirty(0));
+}
+
+testF(ShadowModuleTest, setDecimalPointAt) {
+  shadowPatternWriter.writePattern(kPattern3);
+  shadowModule.clearDigitsDirty();
+
+  shadowPatternWriter.writeDecimalPoint();
+  assertEqual(kPattern3 | 0x80, mPatterns[0]);
+  assertEqual(kPattern3 | 0x80, shadowModule.getPatternAt(0));
+  assertTrue(shadowModule.isDigitDirty(0));
+
+  // Setting the decimal point again is elided.
+  shadowModule.clearDigitsDirty();
+  shadowPatternWriter.writeDecimalPoint();
+  assertFalse(shadowModule.isAnyDigitDirty());
+}
+
+// ----------------------------------------------------------------------
+// Tests for FrameBufferModule.
+// ----------------------------------------------------------------------
+
+class FrameBufferModuleTest : public TestOnce {
+  protected:
+    void setup() override {
+      frameBufferWriter.clear();
+      frameBufferModule.commit();
+      frameBufferModule.publish();
+      mPatterns = frontLedModule.getPatterns();
+    }
+
+    uint8_t* mPatterns;
+};
+
+testF(FrameBufferModuleTest, uncommitted_frame_is_not_published) {
+  frameBufferClockWriter.writeHourMinute24(12, 34);
+  assertEqual(kPattern1, frameBufferModule.getPatternAt(0));
+  assertFalse(frameBufferModule.publish());
+  assertEqual(0, mPatterns[0]);
+  assertEqual(0, mPatterns[3]);
+}
+
+testF(FrameBufferModuleTest, commit_then_publish) {
+  frameBufferClockWriter.writeHourMinute24(12, 34);
+  frameBufferModule.commit();
+  assertTrue(frameBufferModule.publish());
+  assertEqual(kPattern1, mPatterns[0]);
+  assertEqual(kPattern2 | 0x80, mPatterns[1]);
+  assertEqual(kPattern4, mPatterns[3]);
+
+  // Nothing new to publish.
+  assertFalse(frameBufferModule.publish());
+}
+
+testF(FrameBufferModuleTest, back_buffer_retains_committed_frame) {
+  frameBufferClockWriter.writeHourMinute24(12, 34);
+  frameBufferModule.commit();
+
+  // Update only the last digit of the next frame.
+  frameBufferWriter.pos(3);
+  frameBufferWriter.writePattern(kPattern5);
+  frameBufferModule.commit();
+  frameBufferModule.publish();
+  assertEqual(kPattern1, mPatterns[0]);
+  assertEqual(kPattern2 | 0x80, mPatterns[1]);
+  assertEqual(kPattern3, mPatterns[2]);
+  assertEqual(kPattern5, mPatterns[3]);
+}
+
+// ----------------------------------------------------------------------
+// Tests for ChainedModule.
+// ----------------------------------------------------------------------
+
+class ChainedModuleTest : public TestOnce {
+  protected:
+    void setup() override {
+      chainedPatternWriter.clear();
+      chainedModule.flush();
+      leftBulkModule.resetCounts();
+      rightBulkModule.resetCounts();
+      mLeft = leftBulkModule.getPatterns();
+      mRight = rightBulkModule.getPatterns();
+    }
+
+    // Scroll "ABC" until 'A' reaches the first digit of the first module, then
+    // verify that every digit of the 3 modules was scrolled.
+    template <typename T_SCROLLER>
+    void assertChainScrolls(T_SCROLLER& scroller) {
+      scroller.initScrollLeft("ABC");
+      scroller.scrollLeft(LONG_CHAIN_NUM_DIGITS);
+      uint8_t a = longChainedCharWriter.getPattern('A');
+      uint8_t c = longChainedCharWriter.getPattern('C');
+      uint8_t space = longChainedCharWriter.getPattern(' ');
+      assertEqual(a, chainLedModule0.getPatterns()[0]);
+      assertEqual(c, chainLedModule0.getPatterns()[2]);
+      assertEqual(space, chainLedModule2.getPatterns()[WIDE_NUM_DIGITS - 1]);
+
+      // Scroll right: 'C' on the last digit of the last module.
+      scroller.initScrollRight("ABC");
+      scroller.scrollRight();
+      assertEqual(c, chainLedModule0.getPatterns()[0]);
+      scroller.scrollRight(LONG_CHAIN_NUM_DIGITS - 1);
+      assertEqual(c, chainLedModule2.getPatterns()[WIDE_NUM_DIGITS - 1]);
+      assertEqual(a, chainLedModule2.getPatterns()[WIDE_NUM_DIGITS - 3]);
+      assertEqual(space, chainLedModule0.getPatterns()[0]);
+    }
+
+    uint8_t* mLeft;
+    uint8_t* mRight;
+};
+
+testF(ChainedModuleTest, size) {
+  assertEqual(8, chainedModule.size());
+  assertEqual(8, chainedPatternWriter.size());
+  assertEqual(2, chainedModule.numModules());
+}
+
+testF(ChainedModuleTest, setPatternAt_routes_to_module) {
+  chainedModule.setPatternAt(3, kPattern3);
+  chainedModule.setPatternAt(4, kPattern4);
+  assertEqual(kPattern3, mLeft[3]);
+  assertEqual(kPattern4, mRight[0]);
+  assertEqual(kPattern4, chainedModule.getPatternAt(4));
+
+  chainedModule.setDecimalPointAt(5);
+  assertEqual(0x80, mRight[1]);
+
+  // Out of range is ignored.
+  chainedModule.setPatternAt(8, kPattern8);
+  assertEqual(0, chainedModule.getPatternAt(8));
+}
+
+testF(ChainedModuleTest, full_width_write_is_batched_per_module) {
+  chainedStringWriter.writeString("12345678");
+  assertEqual(kPattern1, mLeft[0]);
+  assertEqual(kPattern4, mLeft[3]);
+  assertEqual(kPattern5, mRight[0]);
+  assertEqual(kPattern8, mRight[3]);
+
+  chainedPatternWriter.home();
+  leftBulkModule.resetCounts();
+  rightBulkModule.resetCounts();
+  chainedPatternWriter.writeRepeatedPattern(kPatternMinus, 8);
+  assertEqual(1, leftBulkModule.numBulkCalls);
+  assertEqual(1, rightBulkModule.numBulkCalls);
+  assertEqual(0, leftBulkModule.numSingleCalls);
+  assertEqual(0, rightBulkModule.numSingleCalls);
+
+  chainedModule.flush();
+  assertEqual(1, leftBulkModule.numFlushes);
+  assertEqual(1, rightBulkModule.numFlushes);
+}
+
+testF(ChainedModuleTest, flush_only_touched_modules) {
+  chainedPatternWriter.pos(5);
+  chainedNumberWriter.writeDigit(0xA);
+  assertFalse(chainedModule.isModuleDirty(0));
+  assertTrue(chainedModule.isModuleDirty(1));
+
+  chainedModule.flush();
+  assertEqual(0, leftBulkModule.numFlushes);
+  assertEqual(1, rightBulkModule.numFlushes);
+  assertFalse(chainedModule.isModuleDirty(1));
+}
+
+testF(ChainedModuleTest, number_across_boundary) {
+  chainedPatternWriter.pos(2);
+  chainedNumberWriter.writeUnsignedDecimal(1234);
+  assertEqual(kPattern1, mLeft[2]);
+  assertEqual(kPattern2, mLeft[3]);
+  assertEqual(kPattern3, mRight[0]);
+  assertEqual(kPattern4, mRight[1]);
+  assertTrue(chainedModule.isModuleDirty(0));
+  assertTrue(chainedModule.isModuleDirty(1));
+}
+
+testF(ChainedModuleTest, modules_without_bulk_setter) {
+  simpleChainedWriter.home();
+  const uint8_t patterns[] = {
+    kPattern1, kPattern2, kPattern3, kPattern4, kPattern5, kPattern6
+  };
+  simpleChainedWriter.writePatterns(patterns, 6);
+  assertEqual(kPattern1, leftLedModule.getPatterns()[0]);
+  assertEqual(kPattern4, leftLedModule.getPatterns()[3]);
+  assertEqual(kPattern5, rightLedModule.getPatterns()[0]);
+  assertEqual(kPattern6, rightLedModule.getPatterns()[1]);
+}
+
+testF(ChainedModuleTest, string_scroller_across_modules) {
+  assertChainScrolls(longChainedScroller);
+  assertChainScrolls(runtimeChainedScroller);
+}
+
+// ----------------------------------------------------------------------
+// Tests for BroadcastModule.
+// ----------------------------------------------------------------------
+
+class BroadcastModuleTest : public TestOnce {
+  protected:
+    void setup() override {
+      broadcastPatternWriter.clear();
+      frontBulkModule.resetCounts();
+      rearBulkModule.resetCounts();
+      mFront = frontBulkModule.getPatterns();
+      mRear = rearBulkModule.getPatterns();
+    }
+
+    uint8_t* mFront;
+    uint8_t* mRear;
+};
+
+testF(BroadcastModuleTest, number_is_mirrored) {
+  broadcastNumberWriter.writeSignedDecimal(-12, 4);
+  for (uint8_t i = 0; i < NUM_DIGITS; ++i) {
+    assertEqual(mFront[i], mRear[i]);
+  }
+  assertEqual(kPatternSpace, mFront[0]);
+  assertEqual(kPatternMinus, mFront[1]);
+  assertEqual(kPattern2, mRear[3]);
+  assertEqual(kPattern2, broadcastModule.getPatternAt(3));
+
+  // Each module receives the rendered patterns once.
+  assertEqual(frontBulkModule.numBulkCalls, rearBulkModule.numBulkCalls);
+  assertEqual(frontBulkModule.numSingleCalls, rearBulkModule.numSingleCalls);
+}
+
+testF(BroadcastModuleTest, decimal_point_and_brightness) {
+  broadcastModule.setDecimalPointAt(1);
+  assertEqual(0x80, mFront[1]);
+  assertEqual(0x80, mRear[1]);
+
+  broadcastModule.setBrightness(3);
+  assertEqual(3, frontBulkModule.getBrightness());
+  assertEqual(3, rearBulkModule.getBrightness());
+
+  broadcastModule.flush();
+  assertEqual(1, frontBulkModule.numFlushes);
+  assertEqual(1, rearBulkModule.numFlushes);
+}
+
+// ----------------------------------------------------------------------
+// Tests for ProfilingModule.
+// ----------------------------------------------------------------------
+
+class ProfilingModuleTest : public TestOnce {
+  protected:
+    void setup() override {
+      profilingPatternWriter.clear();
+      profilingModule.reset();
+    }
+};
+
+testF(ProfilingModuleTest, no_writes) {
+  const ProfilingStats& stats = profilingModule.stats();
+  assertEqual(0, stats.numSetPatternAt);
+  assertEqual(0, stats.numPatterns);
+  assertFalse(stats.hasWrites());
+}
+
+testF(ProfilingModuleTest, counts_and_redundant_writes) {
+  profilingNumberWriter.writeHexWord(0x1200);
+  ProfilingStats stats = profilingModule.snapshot();
+  assertEqual(4, stats.numPatterns);
+  assertEqual(0, stats.numRedundantPatterns);
+  assertEqual(0, stats.minPos);
+  assertEqual(3, stats.maxPos);
+
+  // Rewriting the same number is entirely redundant.
+  profilingPatternWriter.home();
+  profilingNumberWriter.writeHexWord(0x1200);
+  stats = profilingModule.snapshot();
+  assertEqual(4, stats.numPatterns);
+  assertEqual(4, stats.numRedundantPatterns);
+
+  // snapshot() cleared the counters.
+  assertEqual(0, profilingModule.stats().numPatterns);
+}
+
+testF(ProfilingModuleTest, range_of_digits) {
+  profilingPatternWriter.pos(2);
+  profilingPatternWriter.writePattern(kPattern1);
+  profilingModule.setDecimalPointAt(1);
+  profilingModule.setDecimalPointAt(1);
+  profilingModule.setBrightness(2);
+
+  const ProfilingStats& stats = profilingModule.stats();
+  assertEqual(1, stats.numSetPatternAt);
+  assertEqual(0, stats.numSetPatternsAt);
+  assertEqual(2, stats.numSetDecimalPointAt);
+  assertEqual(1, stats.numRedundantDecimalPoints);
+  assertEqual(1, stats.numSetBrightness);
+  assertEqual(1, stats.minPos);
+  assertEqual(2, stats.maxPos);
+  assertEqual(2, profiledLedModule.getBrightness());
+}
+
+testF(ProfilingModuleTest, bulk_setter_follows_module) {
+  // A ProfilingModule has a setPatternsAt() only if the wrapped module has one.
+  bool hasBulk = internal::HasSetPatternsAt<ProfilingModule<LedModule>>::value;
+  assertFalse(hasBulk);
+  hasBulk = internal::HasSetPatternsAt<ProfilingModule<BulkLedModule>>::value;
+  assertTrue(hasBulk);
+
+  // So the writes to a LedModule are counted as single digit writes.
+  profilingNumberWriter.writeHexWord(0x1234);
+  const ProfilingStats& stats = profilingModule.stats();
+  assertEqual(4, stats.numSetPatternAt);
+  assertEqual(0, stats.numSetPatternsAt);
+  assertEqual(4, stats.numPatterns);
+
+  // A module with a setPatternsAt() receives a single call.
+  ProfilingModule<BulkLedModule> bulkProfilingModule(bulkLedModule);
+  PatternWriter<ProfilingModule<BulkLedModule>> writer(bulkProfilingModule);
+  const uint8_t patterns[] = {kPattern1, kPattern2, kPattern3};
+  bulkLedModule.resetCounts();
+  writer.writePatterns(patterns, 3);
+  assertEqual(1, bulkProfilingModule.stats().numSetPatternsAt);
+  assertEqual(3, bulkProfilingModule.stats().numPatterns);
+  assertEqual(1, bulkLedModule.numBulkCalls);
+  assertEqual(0, bulkLedModule.numSingleCalls);
+}
+
+// ----------------------------------------------------------------------
+// Tests for FrameRecorderModule.
+// ----------------------------------------------------------------------
+
+class FrameRecorderModuleTest : public TestOnce {
+  protected:
+    void setup() override {
+      recorderPatternWriter.clear();
+      recorderModule.clearFrames();
+    }
+
+    void writeFrame(uint16_t num, uint32_t nowMillis) {
+      recorderPatternWriter.home();
+      recorderNumberWriter.writeUnsignedDecimal(num, 4);
+      recorderModule.commit(nowMillis);
+    }
+};
+
+testF(FrameRecorderModuleTest, forwards_to_module) {
+  recorderNumberWriter.writeHexWord(0x12AB);
+  assertEqual(kPatternA, recordedLedModule.getPatterns()[2]);
+  assertEqual(0, recorderModule.numFrames());
+}
+
+testF(FrameRecorderModuleTest, bulk_setter_follows_module) {
+  // A FrameRecorderModule has a setPatternsAt() only if the wrapped module has
+  // one, so the PatternWriter does not buffer the patterns of a LedModule.
+  bool hasBulk = internal::HasSetPatternsAt<TestFrameRecorderModule>::value;
+  assertFalse(hasBulk);
+  typedef FrameRecorderModule<BulkLedModule, NUM_DIGITS, 3> BulkRecorderModule;
+  hasBulk = internal::HasSetPatternsAt<BulkRecorderModule>::value;
+  assertTrue(hasBulk);
+
+  // A module with a setPatternsAt() receives a single call.
+  BulkRecorderModule bulkRecorderModule(bulkLedModule);
+  PatternWriter<BulkRecorderModule> writer(bulkRecorderModule);
+  const uint8_t patterns[] = {kPattern1, kPattern2, kPattern3};
+  bulkLedModule.resetCounts();
+  writer.writePatterns(patterns, 3);
+  assertEqual(1, bulkLedModule.numBulkCalls);
+  assertEqual(0, bulkLedModule.numSingleCalls);
+}
+
+testF(FrameRecorderModuleTest, keeps_last_frames) {
+  writeFrame(1, 100);
+  writeFrame(2, 200);
+  assertEqual(2, recorderModule.numFrames());
+  assertEqual((uint32_t) 100, recorderModule.frameMillis(0));
+  assertEqual(kPattern1, recorderModule.framePatternAt(0, 3));
+  assertEqual(kPattern2, recorderModule.framePatternAt(1, 3));
+
+  // The 4th frame overwrites the oldest.
+  writeFrame(3, 300);
+  writeFrame(4, 400);
+  assertEqual(3, recorderModule.numFrames());
+  assertEqual((uint32_t) 200, recorderModule.frameMillis(0));
+  assertEqual((uint32_t) 400, recorderModule.frameMillis(2));
+  assertEqual(kPattern4, recorderModule.framePatternAt(2, 3));
+}
+
+testF(FrameRecorderModuleTest, dump) {
+  recorderPatternWriter.home();
+  recorderNumberWriter.writeUnsignedDecimal(123, 4);
+  recorderPatternWriter.writeDecimalPoint();
+  recorderModule.commit(123456);
+  writeFrame(45, 0x12345678);
+
+  ace_common::PrintStr<64> printStr;
+  recorderModule.dump(printStr);
+  // Print::println() terminates each line with "\r\n".
+  assertEqual(
+      "0001E240 00065BCF\r\n"
+      "12345678 0000666D\r\n",
+      printStr.cstr());
+}
+
 // ----------------------------------------------------------------------
 // Tests for CharWriter.
 // ----------------------------------------------------------------------
@@ -86,6 +806,57 @@ testF(CharWriterTest, writeChar) {
   assertEqual(0, mPatterns[4]);
 }
 
+test(CharWriterTest, default_font_matches_kCharPatterns) {
+  assertEqual(kFirstPrintableChar, charWriter.getFirstChar());
+  assertEqual(kNumPrintableCharPatterns, charWriter.getNumChars());
+  for (uint8_t c = 0; c < kNumCharPatterns; c++) {
+    assertEqual(pgm_read_byte(&kCharPatterns[c]), charWriter.getPattern(c));
+  }
+  assertEqual(kPatternUnknown, charWriter.getPattern((char) 0xFF));
+}
+
+test(CharWriterTest, dense_font_with_offset) {
+  // Digits only, using the first 10 patterns of kDigitPatterns.
+  const CharFont digitFont = {kDigitPatterns, '0', 10};
+  CharWriter<LedModule> digitCharWriter(patternWriter, digitFont);
+  assertEqual(kPattern0, digitCharWriter.getPattern('0'));
+  assertEqual(kPattern9, digitCharWriter.getPattern('9'));
+  assertEqual(kPatternUnknown, digitCharWriter.getPattern('/'));
+  assertEqual(kPatternUnknown, digitCharWriter.getPattern(':'));
+  assertEqual(kPatternUnknown, digitCharWriter.getPattern(' '));
+}
+
+static const uint8_t SYMBOL_PAIRS[] PROGMEM = {
+  ' ', kPatternSpace,
+  '-', kPatternMinus,
+  'C', kPatternC,
+  'F', kPatternF,
+  'o', kPatternDeg,
+};
+
+test(CharWriterTest, sparse_font) {
+  const SparseCharFont symbolFont = {SYMBOL_PAIRS, 5};
+  SparseCharWriter<LedModule> symbolCharWriter(patternWriter, symbolFont);
+  assertEqual(5, symbolCharWriter.getNumChars());
+  assertEqual(kPatternSpace, symbolCharWriter.getPattern(' '));
+  assertEqual(kPatternMinus, symbolCharWriter.getPattern('-'));
+  assertEqual(kPatternC, symbolCharWriter.getPattern('C'));
+  assertEqual(kPatternF, symbolCharWriter.getPattern('F'));
+  assertEqual(kPatternDeg, symbolCharWriter.getPattern('o'));
+  assertEqual(kPatternUnknown, symbolCharWriter.getPattern('A'));
+  assertEqual(kPatternUnknown, symbolCharWriter.getPattern('\0'));
+  assertEqual(kPatternUnknown, symbolCharWriter.getPattern('z'));
+
+  patternWriter.clear();
+  symbolCharWriter.writeChar('-');
+  symbolCharWriter.writeChar('o');
+  symbolCharWriter.writeChar('F');
+  uint8_t* patterns = ledModule.getPatterns();
+  assertEqual(kPatternMinus, patterns[0]);
+  assertEqual(kPatternDeg, patterns[1]);
+  assertEqual(kPatternF, patterns[2]);
+}
+
 // ----------------------------------------------------------------------
 // Tests for StringWriter.
 // ----------------------------------------------------------------------
@@ -110,17 +881,731 @@ class StringWriterTest : public TestOnce {
     uint8_t* mPatterns;
 };
 
-testF(StringWriterTest, writeString) {
-  stringWriter.writeString(".1.2.3");
+testF(StringWriterTest, writeString) {
+  stringWriter.writeString(".1.2.3");
+
+  // Should be (".", "1.", "2.", "3") as the 4 digits
+  assertPatternsEqual(
+    4,
+    kPatternSpace | 0x80,
+    kPattern1 | 0x80,
+    kPattern2 | 0x80,
+    kPattern3
+  );
+}
+
+// ----------------------------------------------------------------------
+// Tests for ConstPatterns.
+// ----------------------------------------------------------------------
+
+ACE_SEGMENT_WRITER_CONST_PATTERNS(DotsLabel, ".1.2.3");
+ACE_SEGMENT_WRITER_CONST_PATTERNS(ErrLabel, "Err");
+ACE_SEGMENT_WRITER_CONST_PATTERNS(MultiDotsLabel, "..A..b");
+
+static_assert(DotsLabel::kLength == 4, "'.' must be folded");
+static_assert(ErrLabel::kLength == 3, "no '.' to fold");
+static_assert(MultiDotsLabel::kLength == 4, "leading '.' take a digit");
+
+// ----------------------------------------------------------------------
+// Tests for PatternStorage.
+// ----------------------------------------------------------------------
+
+test(PatternStorageTest, const_tables_match_progmem_tables) {
+  for (uint8_t i = 0; i < kNumDigitPatterns; i++) {
+    assertEqual(pgm_read_byte(&kDigitPatterns[i]),
+        RamStorage::readPattern(RamStorage::digitPatterns() + i));
+  }
+  for (uint8_t i = 0; i < kNumPrintableCharPatterns; i++) {
+    assertEqual(pgm_read_byte(&kPrintableCharPatterns[i]),
+        RamStorage::readPattern(RamStorage::printableCharPatterns() + i));
+  }
+}
+
+test(PatternStorageTest, ram_writers) {
+  uint8_t* patterns = ramLedModule.getPatterns();
+
+  ramPatternWriter.home();
+  ramClockWriter.writeHourMinute24(12, 34);
+  assertEqual(kPattern1, patterns[0]);
+  assertEqual(kPattern2 | 0x80, patterns[1]);
+  assertEqual(kPattern4, patterns[3]);
+
+  ramPatternWriter.home();
+  ramStringWriter.writeString("Ab-");
+  assertEqual(kPatternA, patterns[0]);
+  assertEqual(kPatternB, patterns[1]);
+  assertEqual(kPatternMinus, patterns[2]);
+
+  // The lookup can be folded at compile time.
+  static_assert(
+      internal::ConstPatternTables<>::kDigitPatterns[7] == kPattern7,
+      "digit 7");
+}
+
+test(ConstPatternsTest, font_matches_kCharPatterns) {
+  for (uint8_t c = 0; c < kNumCharPatterns; c++) {
+    assertEqual(pgm_read_byte(&kCharPatterns[c]),
+        internal::constCharPattern(c));
+  }
+}
+
+testF(StringWriterTest, constPatterns_match_writeString) {
+  uint8_t len = stringWriter.writeString(".1.2.3");
+  assertEqual(DotsLabel::kLength, len);
+  for (uint8_t i = 0; i < len; i++) {
+    assertEqual(pgm_read_byte(&DotsLabel::kPatterns[i]), mPatterns[i]);
+  }
+
+  stringWriter.clear();
+  len = stringWriter.writeString("Err");
+  assertEqual(ErrLabel::kLength, len);
+  for (uint8_t i = 0; i < len; i++) {
+    assertEqual(pgm_read_byte(&ErrLabel::kPatterns[i]), mPatterns[i]);
+  }
+
+  stringWriter.clear();
+  len = stringWriter.writeString("..A..b");
+  assertEqual(MultiDotsLabel::kLength, len);
+  for (uint8_t i = 0; i < len; i++) {
+    assertEqual(pgm_read_byte(&MultiDotsLabel::kPatterns[i]), mPatterns[i]);
+  }
+}
+
+testF(StringWriterTest, constPatterns_writePatterns_P) {
+  patternWriter.writePatterns_P(DotsLabel::kPatterns, DotsLabel::kLength);
+  assertPatternsEqual(
+    4,
+    kPatternSpace | 0x80,
+    kPattern1 | 0x80,
+    kPattern2 | 0x80,
+    kPattern3
+  );
+}
+
+// ----------------------------------------------------------------------
+// Tests for StringScroller.
+// ----------------------------------------------------------------------
+
+class StringScrollerTest : public TestOnce {
+  protected:
+    void setup() override {
+      mPatterns = ledModule.getPatterns();
+    }
+
+    // Verify that the display shows the 4 characters of `s`.
+    void assertDisplay(const char* s) {
+      for (uint8_t i = 0; i < NUM_DIGITS; i++) {
+        assertEqual(charWriter.getPattern(s[i]), mPatterns[i]);
+      }
+    }
+
+    uint8_t* mPatterns;
+};
+
+testF(StringScrollerTest, scrollLeft) {
+  stringScroller.initScrollLeft("ABC");
+  assertDisplay("    ");
+  assertFalse(stringScroller.scrollLeft()); assertDisplay("   A");
+  assertFalse(stringScroller.scrollLeft()); assertDisplay("  AB");
+  assertFalse(stringScroller.scrollLeft()); assertDisplay(" ABC");
+  assertFalse(stringScroller.scrollLeft()); assertDisplay("ABC ");
+  assertFalse(stringScroller.scrollLeft()); assertDisplay("BC  ");
+  assertFalse(stringScroller.scrollLeft()); assertDisplay("C   ");
+  assertFalse(stringScroller.scrollLeft()); assertDisplay("    ");
+  assertTrue(stringScroller.scrollLeft()); assertDisplay("    ");
+}
+
+testF(StringScrollerTest, scrollRight) {
+  stringScroller.initScrollRight(F("ABC"));
+  assertDisplay("    ");
+  assertFalse(stringScroller.scrollRight()); assertDisplay("C   ");
+  assertFalse(stringScroller.scrollRight()); assertDisplay("BC  ");
+  assertFalse(stringScroller.scrollRight()); assertDisplay("ABC ");
+  assertFalse(stringScroller.scrollRight()); assertDisplay(" ABC");
+  assertFalse(stringScroller.scrollRight()); assertDisplay("  AB");
+  assertFalse(stringScroller.scrollRight()); assertDisplay("   A");
+  assertFalse(stringScroller.scrollRight()); assertDisplay("    ");
+  assertTrue(stringScroller.scrollRight()); assertDisplay("    ");
+}
+
+// A Stream which reads from a c-string.
+class CStringStream : public Stream {
+  public:
+    explicit CStringStream(const char* s) : mS(s) {}
+    int available() override { return strlen(mS); }
+    int read() override { return (*mS) ? *mS++ : -1; }
+    int peek() override { return (*mS) ? *mS : -1; }
+    size_t write(uint8_t) override { return 0; }
+
+  private:
+    const char* mS;
+};
+
+// A CharSource which returns the letters 'A' to 'Z' repeatedly, until
+// `*context` characters have been returned.
+static int countingSource(void* context) {
+  uint16_t* remaining = (uint16_t*) context;
+  if (*remaining == 0) return -1;
+  (*remaining)--;
+  return 'A' + (*remaining % 26);
+}
+
+testF(StringScrollerTest, scrollLeft_stream) {
+  CStringStream stream("ABC");
+  stringScroller.initScrollLeft(stream);
+  assertDisplay("    ");
+  assertFalse(stringScroller.scrollLeft()); assertDisplay("   A");
+  assertFalse(stringScroller.scrollLeft()); assertDisplay("  AB");
+  assertFalse(stringScroller.scrollLeft()); assertDisplay(" ABC");
+  assertFalse(stringScroller.scrollLeft()); assertDisplay("ABC ");
+  assertFalse(stringScroller.scrollLeft()); assertDisplay("BC  ");
+  assertFalse(stringScroller.scrollLeft()); assertDisplay("C   ");
+  assertFalse(stringScroller.scrollLeft()); assertDisplay("    ");
+  assertTrue(stringScroller.scrollLeft()); assertDisplay("    ");
+
+  // A streaming source cannot scroll right.
+  assertTrue(stringScroller.scrollRight());
+}
+
+testF(StringScrollerTest, scrollLeft_longer_than_255_characters) {
+  // 1000 characters from a callback, plus 4 steps to clear the display.
+  uint16_t remaining = 1000;
+  stringScroller.initScrollLeft(countingSource, &remaining);
+  uint16_t steps = 0;
+  while (! stringScroller.scrollLeft()) {
+    steps++;
+  }
+  assertEqual(1000 + NUM_DIGITS, steps);
+  assertDisplay("    ");
+}
+
+testF(StringScrollerTest, wider_than_ring_buffer) {
+  uint8_t* patterns = extraWideLedModule.getPatterns();
+  const uint8_t n = EXTRA_WIDE_NUM_DIGITS;
+
+  // String: "ABC" enters at the rightmost digit, and crosses all 20 digits.
+  extraWideStringScroller.initScrollLeft("ABC");
+  extraWideStringScroller.scrollLeft(3);
+  assertEqual(charWriter.getPattern('A'), patterns[n - 3]);
+  assertEqual(charWriter.getPattern('C'), patterns[n - 1]);
+  extraWideStringScroller.scrollLeft(n - 3);
+  assertEqual(charWriter.getPattern('A'), patterns[0]);
+  assertEqual(charWriter.getPattern('C'), patterns[2]);
+  assertEqual(charWriter.getPattern(' '), patterns[n - 1]);
+
+  extraWideStringScroller.initScrollRight("ABC");
+  extraWideStringScroller.scrollRight(n);
+  assertEqual(charWriter.getPattern('C'), patterns[n - 1]);
+  assertEqual(charWriter.getPattern('A'), patterns[n - 3]);
+  assertFalse(extraWideStringScroller.isDone());
+  extraWideStringScroller.scrollRight(3);
+  assertTrue(extraWideStringScroller.isDone());
+
+  // Streaming source.
+  CStringStream stream("ABC");
+  extraWideStringScroller.initScrollLeft(stream);
+  for (uint8_t i = 0; i < 3; i++) {
+    assertFalse(extraWideStringScroller.scrollLeft());
+  }
+  assertEqual(charWriter.getPattern('A'), patterns[n - 3]);
+  assertEqual(charWriter.getPattern('C'), patterns[n - 1]);
+  extraWideStringScroller.scrollLeft(n - 3);
+  assertEqual(charWriter.getPattern('A'), patterns[0]);
+  assertEqual(charWriter.getPattern('C'), patterns[2]);
+  assertEqual(charWriter.getPattern(' '), patterns[3]);
+  assertFalse(extraWideStringScroller.scrollLeft(3));
+  assertTrue(extraWideStringScroller.scrollLeft());
+  for (uint8_t i = 0; i < n; i++) {
+    assertEqual(charWriter.getPattern(' '), patterns[i]);
+  }
+}
+
+testF(StringScrollerTest, scroll_step_is_batched) {
+  bulkStringScroller.initScrollLeft("ABCDEF");
+  for (uint8_t i = 0; i < 6; i++) {
+    bulkLedModule.resetCounts();
+    bulkStringScroller.scrollLeft();
+    assertEqual(0, bulkLedModule.numSingleCalls);
+    assertLessOrEqual(bulkLedModule.numBulkCalls, 2);
+  }
+  uint8_t* patterns = bulkLedModule.getPatterns();
+  assertEqual(bulkCharWriter.getPattern('C'), patterns[0]);
+  assertEqual(bulkCharWriter.getPattern('F'), patterns[3]);
+}
+
+testF(StringScrollerTest, scrollLeft_multiple_steps) {
+  stringScroller.initScrollLeft("ABC");
+  assertFalse(stringScroller.scrollLeft(3)); assertDisplay(" ABC");
+  assertFalse(stringScroller.scrollLeft(4)); assertDisplay("    ");
+  assertTrue(stringScroller.scrollLeft(2)); assertDisplay("    ");
+}
+
+testF(StringScrollerTest, tick) {
+  bulkStringScroller.setFramePeriod(100);
+  bulkStringScroller.initScrollRight("ABCDEF");
+  bulkLedModule.resetCounts();
+
+  // The first tick() starts the schedule, and writes nothing.
+  assertEqual(0, bulkStringScroller.tick(1000));
+  assertEqual(0, bulkStringScroller.tick(1099));
+  assertEqual(0, bulkLedModule.numBulkCalls);
+  assertEqual(0, bulkLedModule.numSingleCalls);
+
+  // One step due.
+  assertEqual(1, bulkStringScroller.tick(1100));
+  uint8_t* patterns = bulkLedModule.getPatterns();
+  assertEqual(bulkCharWriter.getPattern('F'), patterns[0]);
+
+  // Fell behind by 3 steps, intermediate frames are skipped.
+  bulkLedModule.resetCounts();
+  assertEqual(3, bulkStringScroller.tick(1450));
+  assertLessOrEqual(bulkLedModule.numBulkCalls, 2);
+  assertEqual(bulkCharWriter.getPattern('C'), patterns[0]);
+  assertEqual(bulkCharWriter.getPattern('F'), patterns[3]);
+
+  // The schedule stays on the 100 ms grid.
+  assertEqual(0, bulkStringScroller.tick(1499));
+  assertEqual(1, bulkStringScroller.tick(1500));
+  assertFalse(bulkStringScroller.isDone());
+
+  // Run to the end, then nothing more is written.
+  assertEqual(100, bulkStringScroller.tick(11500));
+  assertTrue(bulkStringScroller.isDone());
+  bulkLedModule.resetCounts();
+  assertEqual(0, bulkStringScroller.tick(11600));
+  assertEqual(0, bulkLedModule.numBulkCalls);
+}
+
+// ----------------------------------------------------------------------
+// Tests for FrameTicker.
+// ----------------------------------------------------------------------
+
+test(FrameTickerTest, tick) {
+  FrameTicker ticker(50);
+  assertEqual(50, ticker.getFramePeriod());
+  assertEqual(0, ticker.tick(65480));
+  assertEqual(0, ticker.tick(65529));
+  assertEqual(1, ticker.tick(65530));
+
+  // Wraps around the uint16_t millis, and skips frames.
+  assertEqual(2, ticker.tick(94)); // 65530 + 100 = 94 (mod 65536)
+  assertEqual(0, ticker.tick(143));
+  assertEqual(1, ticker.tick(144));
+
+  ticker.reset();
+  assertEqual(0, ticker.tick(200));
+  assertEqual(1, ticker.tick(250));
+}
+
+// ----------------------------------------------------------------------
+// Tests for NumberFilter.
+// ----------------------------------------------------------------------
+
+test(NumberFilterTest, no_filter) {
+  NumberFilter filter;
+  assertTrue(filter.update(100, 0));
+  assertEqual((int32_t) 100, filter.value());
+  assertFalse(filter.update(100, 10));
+  assertTrue(filter.update(101, 20));
+  assertEqual((int32_t) 101, filter.value());
+}
+
+test(NumberFilterTest, deadband_and_min_interval) {
+  NumberFilter filter(1 /*deadband*/, 1000 /*minIntervalMillis*/);
+  assertTrue(filter.update(100, 0));
+
+  // Jitter of +/-1 is held until the interval has elapsed.
+  uint8_t numChanges = 0;
+  for (uint16_t t = 10; t < 1000; t += 10) {
+    numChanges += filter.update((t & 0x10) ? 101 : 99, t);
+  }
+  assertEqual(0, numChanges);
+  assertEqual((int32_t) 100, filter.value());
+  assertTrue(filter.update(101, 1000));
+  assertEqual((int32_t) 101, filter.value());
+  assertFalse(filter.update(100, 1010));
+
+  // A change larger than the deadband is displayed immediately.
+  assertTrue(filter.update(98, 1020));
+  assertEqual((int32_t) 98, filter.value());
+  assertTrue(filter.update(-5, 1030));
+  assertEqual((int32_t) -5, filter.value());
+}
+
+test(NumberFilterTest, hold_without_min_interval) {
+  NumberFilter filter(2 /*deadband*/);
+  assertTrue(filter.update(-100, 0));
+  assertFalse(filter.update(-98, 60000));
+  assertTrue(filter.update(-97, 60010));
+  assertEqual((int32_t) -97, filter.value());
+}
+
+test(NumberFilterTest, smoothing) {
+  NumberFilter filter(0, 0, 2 /*smoothingShift*/);
+  assertTrue(filter.update(100, 0));
+
+  // Each reading moves the average by 1/4 of the difference.
+  assertTrue(filter.update(200, 10));
+  assertEqual((int32_t) 125, filter.value());
+  filter.update(200, 20);
+  assertEqual((int32_t) 143, filter.value());
+
+  // The average converges to a constant reading.
+  for (uint8_t i = 0; i < 50; i++) {
+    filter.update(200, 30);
+  }
+  assertEqual((int32_t) 200, filter.value());
+
+  // Also when the reading is approached from above.
+  for (uint8_t i = 0; i < 50; i++) {
+    filter.update(90, 40);
+  }
+  assertEqual((int32_t) 90, filter.value());
+
+  filter.setSmoothing(0);
+  assertTrue(filter.update(-7, 50));
+  assertEqual((int32_t) -7, filter.value());
+}
+
+// ----------------------------------------------------------------------
+// Tests for AnimationPlayer.
+// ----------------------------------------------------------------------
+
+const uint8_t ANIMATION_FRAMES[3][NUM_DIGITS] PROGMEM = {
+  { 0x01, 0x02, 0x03, 0x04 },
+  { 0x01, 0x12, 0x13, 0x04 },
+  { 0x21, 0x12, 0x13, 0x24 },
+};
+
+const uint16_t ANIMATION_DURATIONS[3] PROGMEM = {100, 200, 0};
+
+const Animation ANIMATION = {
+  &ANIMATION_FRAMES[0][0], ANIMATION_DURATIONS, 3, NUM_DIGITS, 0
+};
+
+const Animation FIXED_PERIOD_ANIMATION = {
+  &ANIMATION_FRAMES[0][0], nullptr, 3, NUM_DIGITS, 50
+};
+
+class AnimationPlayerTest : public TestOnce {
+  protected:
+    void setup() override {
+      bulkPatternWriter.clear();
+      bulkLedModule.resetCounts();
+      mPatterns = bulkLedModule.getPatterns();
+    }
+
+    uint8_t* mPatterns;
+};
+
+testF(AnimationPlayerTest, first_tick_draws_whole_frame) {
+  animationPlayer.play(ANIMATION);
+  assertFalse(animationPlayer.isDone());
+  assertTrue(animationPlayer.tick(1000));
+  assertEqual(0, animationPlayer.getFrame());
+  assertEqual(1, bulkLedModule.numBulkCalls);
+  assertEqual(0x01, mPatterns[0]);
+  assertEqual(0x04, mPatterns[3]);
+
+  // Nothing is written until the frame is due.
+  bulkLedModule.resetCounts();
+  assertFalse(animationPlayer.tick(1099));
+  assertEqual(0, bulkLedModule.numBulkCalls);
+}
+
+testF(AnimationPlayerTest, writes_only_changed_digits) {
+  animationPlayer.play(ANIMATION);
+  animationPlayer.tick(1000);
+
+  // Frame 1 changes the 2 middle digits, in a single run.
+  bulkLedModule.resetCounts();
+  assertTrue(animationPlayer.tick(1100));
+  assertEqual(1, animationPlayer.getFrame());
+  assertEqual(1, bulkLedModule.numBulkCalls);
+  assertEqual(0x12, mPatterns[1]);
+  assertEqual(0x13, mPatterns[2]);
+
+  // Frame 2 changes the 2 outer digits, in 2 runs.
+  bulkLedModule.resetCounts();
+  assertTrue(animationPlayer.tick(1300));
+  assertEqual(2, animationPlayer.getFrame());
+  assertEqual(2, bulkLedModule.numBulkCalls);
+  assertEqual(0x21, mPatterns[0]);
+  assertEqual(0x24, mPatterns[3]);
+}
+
+testF(AnimationPlayerTest, loop_and_skip_frames) {
+  animationPlayer.play(FIXED_PERIOD_ANIMATION);
+  animationPlayer.tick(65500);
+
+  // Late tick across the uint16_t rollover skips frame 1, then wraps to 0.
+  assertTrue(animationPlayer.tick(64)); // 65500 + 100 = 64 (mod 65536)
+  assertEqual(2, animationPlayer.getFrame());
+  assertTrue(animationPlayer.tick(114));
+  assertEqual(0, animationPlayer.getFrame());
+  assertEqual(0x01, mPatterns[0]);
+  assertFalse(animationPlayer.isDone());
+}
+
+testF(AnimationPlayerTest, play_once) {
+  animationPlayer.play(FIXED_PERIOD_ANIMATION, false /*loop*/);
+  animationPlayer.tick(0);
+  animationPlayer.tick(100);
+  assertEqual(2, animationPlayer.getFrame());
+  assertFalse(animationPlayer.isDone());
+
+  // The last frame stays on the display.
+  assertFalse(animationPlayer.tick(150));
+  assertTrue(animationPlayer.isDone());
+  assertEqual(2, animationPlayer.getFrame());
+  assertEqual(0x21, mPatterns[0]);
+  assertFalse(animationPlayer.tick(1000));
+}
+
+testF(AnimationPlayerTest, invalidate) {
+  animationPlayer.play(ANIMATION);
+  animationPlayer.tick(0);
+  bulkPatternWriter.clear();
+
+  bulkLedModule.resetCounts();
+  animationPlayer.invalidate();
+  assertTrue(animationPlayer.tick(1));
+  assertEqual(1, bulkLedModule.numBulkCalls);
+  assertEqual(0x01, mPatterns[0]);
+}
+
+testF(AnimationPlayerTest, nextFrame) {
+  animationPlayer.play(ANIMATION, false /*loop*/);
+  assertTrue(animationPlayer.nextFrame(1000));
+  assertEqual(0, animationPlayer.getFrame());
+
+  // Each call advances one frame, even if the frame is not due yet.
+  bulkLedModule.resetCounts();
+  assertTrue(animationPlayer.nextFrame(1001));
+  assertEqual(1, animationPlayer.getFrame());
+  assertEqual(1, bulkLedModule.numBulkCalls);
+  assertEqual(0x12, mPatterns[1]);
+
+  // The frame timing restarts at the step.
+  assertFalse(animationPlayer.tick(1200));
+  assertTrue(animationPlayer.tick(1201));
+  assertEqual(2, animationPlayer.getFrame());
+
+  // A non-looping animation stops at its last frame.
+  assertFalse(animationPlayer.nextFrame(1202));
+  assertTrue(animationPlayer.isDone());
+  assertEqual(2, animationPlayer.getFrame());
+}
+
+// ----------------------------------------------------------------------
+// Tests for CompressedAnimation.
+// ----------------------------------------------------------------------
+
+const uint8_t SPIN_FRAMES[6][NUM_DIGITS] = {
+  { 0x03, 0x03, 0x03, 0x03 },
+  { 0x06, 0x06, 0x06, 0x06 },
+  { 0x0c, 0x0c, 0x0c, 0x0c },
+  { 0x18, 0x18, 0x18, 0x18 },
+  { 0x30, 0x30, 0x30, 0x30 },
+  { 0x21, 0x21, 0x21, 0x21 },
+};
+
+test(CompressAnimationFramesTest, repeat_runs) {
+  const uint8_t expected[] = {
+    repeatRun(0, 4), 0x03, kRunFrameEnd,
+    repeatRun(0, 4), 0x06, kRunFrameEnd,
+    repeatRun(0, 4), 0x0c, kRunFrameEnd,
+    repeatRun(0, 4), 0x18, kRunFrameEnd,
+    repeatRun(0, 4), 0x30, kRunFrameEnd,
+    repeatRun(0, 4), 0x21, kRunFrameEnd,
+    repeatRun(0, 4), 0x03, kRunFrameEnd,
+  };
+  uint8_t out[32];
+  uint16_t size = compressAnimationFrames(
+      &SPIN_FRAMES[0][0], 6, NUM_DIGITS, out, sizeof(out));
+  assertEqual(sizeof(expected), size);
+  for (uint16_t i = 0; i < size; i++) {
+    assertEqual(expected[i], out[i]);
+  }
+}
+
+test(CompressAnimationFramesTest, skip_and_literal_runs) {
+  const uint8_t frames[3][NUM_DIGITS] = {
+    { 0x01, 0x02, 0x03, 0x04 },
+    { 0x01, 0x12, 0x13, 0x04 },
+    { 0x21, 0x12, 0x13, 0x24 },
+  };
+  const uint8_t expected[] = {
+    literalRun(0, 4), 0x01, 0x02, 0x03, 0x04, kRunFrameEnd,
+    literalRun(1, 2), 0x12, 0x13, kRunFrameEnd,
+    literalRun(0, 1), 0x21, literalRun(2, 1), 0x24, kRunFrameEnd,
+    literalRun(0, 4), 0x01, 0x02, 0x03, 0x04, kRunFrameEnd,
+  };
+  uint8_t out[32];
+  uint16_t size = compressAnimationFrames(
+      &frames[0][0], 3, NUM_DIGITS, out, sizeof(out));
+  assertEqual(sizeof(expected), size);
+  for (uint16_t i = 0; i < size; i++) {
+    assertEqual(expected[i], out[i]);
+  }
+
+  // Calculate the size only, and detect a buffer which is too small.
+  assertEqual(sizeof(expected), compressAnimationFrames(
+      &frames[0][0], 3, NUM_DIGITS, nullptr, 0));
+  assertEqual(0, compressAnimationFrames(
+      &frames[0][0], 3, NUM_DIGITS, out, sizeof(expected) - 1));
+}
+
+const uint8_t COMPRESSED_FRAMES[] PROGMEM = {
+  literalRun(0, 4), 0x01, 0x02, 0x03, 0x04, kRunFrameEnd,
+  literalRun(1, 2), 0x12, 0x13, kRunFrameEnd,
+  literalRun(0, 1), 0x21, literalRun(2, 1), 0x24, kRunFrameEnd,
+  literalRun(0, 4), 0x01, 0x02, 0x03, 0x04, kRunFrameEnd,
+};
+
+const CompressedAnimation COMPRESSED_ANIMATION = {
+  COMPRESSED_FRAMES, nullptr, 3, NUM_DIGITS, 50
+};
+
+class CompressedAnimationPlayerTest : public TestOnce {
+  protected:
+    void setup() override {
+      bulkPatternWriter.clear();
+      bulkLedModule.resetCounts();
+      mPatterns = bulkLedModule.getPatterns();
+    }
+
+    uint8_t* mPatterns;
+};
+
+testF(CompressedAnimationPlayerTest, writes_only_changed_digits) {
+  compressedPlayer.play(COMPRESSED_ANIMATION);
+  assertTrue(compressedPlayer.tick(1000));
+  assertEqual(1, bulkLedModule.numBulkCalls);
+  assertEqual(0x01, mPatterns[0]);
+  assertEqual(0x04, mPatterns[3]);
+
+  bulkLedModule.resetCounts();
+  assertFalse(compressedPlayer.tick(1049));
+  assertTrue(compressedPlayer.tick(1050));
+  assertEqual(1, compressedPlayer.getFrame());
+  assertEqual(1, bulkLedModule.numBulkCalls);
+  assertEqual(0x12, mPatterns[1]);
+  assertEqual(0x13, mPatterns[2]);
+
+  bulkLedModule.resetCounts();
+  assertTrue(compressedPlayer.tick(1100));
+  assertEqual(2, bulkLedModule.numBulkCalls);
+  assertEqual(0x21, mPatterns[0]);
+  assertEqual(0x24, mPatterns[3]);
+}
 
-  // Should be (".", "1.", "2.", "3") as the 4 digits
-  assertPatternsEqual(
-    4,
-    kPatternSpace | 0x80,
-    kPattern1 | 0x80,
-    kPattern2 | 0x80,
-    kPattern3
-  );
+testF(CompressedAnimationPlayerTest, loop_and_skip_frames) {
+  compressedPlayer.play(COMPRESSED_ANIMATION);
+  compressedPlayer.tick(0);
+
+  // Frames 1 and 2 are decoded together, then all 4 digits are written once.
+  bulkLedModule.resetCounts();
+  assertTrue(compressedPlayer.tick(100));
+  assertEqual(2, compressedPlayer.getFrame());
+  assertEqual(1, bulkLedModule.numBulkCalls);
+  assertEqual(0x21, mPatterns[0]);
+  assertEqual(0x12, mPatterns[1]);
+
+  // The loop frame restores frame 0, and the next frame is frame 1 again.
+  assertTrue(compressedPlayer.tick(150));
+  assertEqual(0, compressedPlayer.getFrame());
+  assertEqual(0x01, mPatterns[0]);
+  assertEqual(0x02, mPatterns[1]);
+  assertTrue(compressedPlayer.tick(200));
+  assertEqual(1, compressedPlayer.getFrame());
+  assertEqual(0x12, mPatterns[1]);
+
+  // A full cycle between 2 ticks ends on the same frame.
+  compressedPlayer.tick(350);
+  assertEqual(1, compressedPlayer.getFrame());
+  assertEqual(0x01, mPatterns[0]);
+  assertEqual(0x12, mPatterns[1]);
+  assertEqual(0x13, mPatterns[2]);
+  assertEqual(0x04, mPatterns[3]);
+}
+
+testF(CompressedAnimationPlayerTest, play_once) {
+  compressedPlayer.play(COMPRESSED_ANIMATION, false /*loop*/);
+  compressedPlayer.tick(0);
+  compressedPlayer.tick(100);
+  assertFalse(compressedPlayer.isDone());
+  assertFalse(compressedPlayer.tick(150));
+  assertTrue(compressedPlayer.isDone());
+  assertEqual(2, compressedPlayer.getFrame());
+  assertEqual(0x21, mPatterns[0]);
+}
+
+testF(CompressedAnimationPlayerTest, nextFrame) {
+  compressedPlayer.play(COMPRESSED_ANIMATION);
+  assertTrue(compressedPlayer.nextFrame(0));
+  assertEqual(0, compressedPlayer.getFrame());
+
+  // Each call decodes exactly one frame.
+  assertTrue(compressedPlayer.nextFrame(1));
+  assertEqual(1, compressedPlayer.getFrame());
+  assertEqual(0x01, mPatterns[0]);
+  assertEqual(0x12, mPatterns[1]);
+  assertTrue(compressedPlayer.nextFrame(2));
+  assertEqual(2, compressedPlayer.getFrame());
+  assertEqual(0x21, mPatterns[0]);
+
+  // A looping animation wraps to the first frame.
+  assertTrue(compressedPlayer.nextFrame(3));
+  assertEqual(0, compressedPlayer.getFrame());
+  assertEqual(0x01, mPatterns[0]);
+  assertEqual(0x02, mPatterns[1]);
+  assertFalse(compressedPlayer.tick(52));
+}
+
+// Frame 0 writes only digit 1, and relies on the blank display for the others.
+const uint8_t SPARSE_COMPRESSED_FRAMES[] PROGMEM = {
+  literalRun(1, 1), 0x06, kRunFrameEnd,
+  kRunFrameEnd,
+};
+
+const CompressedAnimation SPARSE_COMPRESSED_ANIMATION = {
+  SPARSE_COMPRESSED_FRAMES, nullptr, 1, NUM_DIGITS, 50
+};
+
+testF(CompressedAnimationPlayerTest, first_frame_starts_blank) {
+  CompressedAnimationPlayer<BulkLedModule> player(bulkPatternWriter);
+  player.play(SPARSE_COMPRESSED_ANIMATION);
+  assertTrue(player.tick(0));
+  assertEqual(0x00, mPatterns[0]);
+  assertEqual(0x06, mPatterns[1]);
+  assertEqual(0x00, mPatterns[2]);
+  assertEqual(0x00, mPatterns[3]);
+
+  // Also after the buffer was filled by another animation.
+  player.play(COMPRESSED_ANIMATION);
+  player.tick(100);
+  assertEqual(0x04, mPatterns[3]);
+  player.play(SPARSE_COMPRESSED_ANIMATION);
+  assertTrue(player.tick(200));
+  assertEqual(0x00, mPatterns[0]);
+  assertEqual(0x06, mPatterns[1]);
+  assertEqual(0x00, mPatterns[3]);
+}
+
+testF(CompressedAnimationPlayerTest, matches_raw_frames) {
+  uint8_t data[32];
+  compressAnimationFrames(&SPIN_FRAMES[0][0], 6, NUM_DIGITS, data, 32);
+  const CompressedAnimation animation = {data, nullptr, 6, NUM_DIGITS, 10};
+  compressedPlayer.play(animation);
+  for (uint16_t t = 0; t < 130; t += 10) {
+    compressedPlayer.tick(t);
+    uint8_t frame = (t / 10) % 6;
+    assertEqual(frame, compressedPlayer.getFrame());
+    for (uint8_t i = 0; i < NUM_DIGITS; i++) {
+      assertEqual(SPIN_FRAMES[frame][i], mPatterns[i]);
+    }
+  }
 }
 
 // ----------------------------------------------------------------------
@@ -357,6 +1842,94 @@ testF(NumberWriterTest, writeSignedDecimal_boxed) {
   assertEqual(kPattern2, mPatterns[3]);
 }
 
+testF(NumberWriterTest, writeUnsignedDecimal32) {
+  wideNumberWriter.home();
+  uint8_t written = wideNumberWriter.writeUnsignedDecimal32(123456);
+  uint8_t* patterns = wideLedModule.getPatterns();
+  assertEqual(6, written);
+  assertEqual(kPattern1, patterns[0]);
+  assertEqual(kPattern2, patterns[1]);
+  assertEqual(kPattern3, patterns[2]);
+  assertEqual(kPattern4, patterns[3]);
+  assertEqual(kPattern5, patterns[4]);
+  assertEqual(kPattern6, patterns[5]);
+
+  // Largest number spills over the end of the 4-digit module.
+  numberWriter.home();
+  written = numberWriter.writeUnsignedDecimal32(4294967295UL);
+  assertEqual(10, written);
+  assertEqual(kPattern4, mPatterns[0]);
+  assertEqual(kPattern2, mPatterns[1]);
+  assertEqual(kPattern9, mPatterns[2]);
+  assertEqual(kPattern4, mPatterns[3]);
+}
+
+testF(NumberWriterTest, writeSignedDecimal32_boxed) {
+  wideNumberWriter.home();
+  uint8_t written = wideNumberWriter.writeSignedDecimal32(-70000, 6);
+  uint8_t* patterns = wideLedModule.getPatterns();
+  assertEqual(6, written);
+  assertEqual(kPatternMinus, patterns[0]);
+  assertEqual(kPattern7, patterns[1]);
+  assertEqual(kPattern0, patterns[2]);
+  assertEqual(kPattern0, patterns[3]);
+  assertEqual(kPattern0, patterns[4]);
+  assertEqual(kPattern0, patterns[5]);
+
+  wideNumberWriter.home();
+  written = wideNumberWriter.writeSignedDecimal32(-9, 6);
+  assertEqual(6, written);
+  assertEqual(kPatternSpace, patterns[0]);
+  assertEqual(kPatternSpace, patterns[3]);
+  assertEqual(kPatternMinus, patterns[4]);
+  assertEqual(kPattern9, patterns[5]);
+}
+
+testF(NumberWriterTest, writeFixed) {
+  // "-12.34"
+  numberWriter.home();
+  uint8_t written = numberWriter.writeFixed(-1234, 2);
+  assertEqual(5, written);
+  assertEqual(kPatternMinus, mPatterns[0]);
+  assertEqual(kPattern1, mPatterns[1]);
+  assertEqual(kPattern2 | 0x80, mPatterns[2]);
+  assertEqual(kPattern3, mPatterns[3]);
+
+  // "0.05" is padded with a leading zero.
+  numberWriter.clear();
+  written = numberWriter.writeFixed(5, 2);
+  assertEqual(3, written);
+  assertEqual(kPattern0 | 0x80, mPatterns[0]);
+  assertEqual(kPattern0, mPatterns[1]);
+  assertEqual(kPattern5, mPatterns[2]);
+  assertEqual(kPatternSpace, mPatterns[3]);
+
+  // " 1.5" right justified, the decimal point does not take a digit.
+  numberWriter.home();
+  written = numberWriter.writeFixed(15, 1, 4);
+  assertEqual(4, written);
+  assertEqual(kPatternSpace, mPatterns[0]);
+  assertEqual(kPatternSpace, mPatterns[1]);
+  assertEqual(kPattern1 | 0x80, mPatterns[2]);
+  assertEqual(kPattern5, mPatterns[3]);
+
+  // "-0.7 " left justified.
+  numberWriter.clear();
+  written = numberWriter.writeFixed(-7, 1, -4);
+  assertEqual(4, written);
+  assertEqual(kPatternMinus, mPatterns[0]);
+  assertEqual(kPattern0 | 0x80, mPatterns[1]);
+  assertEqual(kPattern7, mPatterns[2]);
+  assertEqual(kPatternSpace, mPatterns[3]);
+
+  // No decimal point when fractionDigits is 0.
+  numberWriter.clear();
+  written = numberWriter.writeFixed(42, 0);
+  assertEqual(2, written);
+  assertEqual(kPattern4, mPatterns[0]);
+  assertEqual(kPattern2, mPatterns[1]);
+}
+
 testF(NumberWriterTest, writeFloat) {
   // Only 2 digits after decimal point are written by default, so this writes
   // "1.23", which writes only 3 digits on the LED because the decimal point is
@@ -376,6 +1949,238 @@ testF(NumberWriterTest, writeFloat) {
   assertEqual(kPattern3, mPatterns[3]);
 }
 
+testF(NumberWriterTest, writeFloat_rounding_and_box) {
+  // "2.00", rounded up like Print::print(double).
+  numberWriter.writeFloat(1.999);
+  assertEqual(kPattern2 | 0x80, mPatterns[0]);
+  assertEqual(kPattern0, mPatterns[1]);
+  assertEqual(kPattern0, mPatterns[2]);
+
+  // "-1.5" right justified in a box of 4 digits.
+  numberWriter.clear();
+  uint8_t written = numberWriter.writeFloat(-1.5, 1, 4);
+  assertEqual(4, written);
+  assertEqual(kPatternSpace, mPatterns[0]);
+  assertEqual(kPatternMinus, mPatterns[1]);
+  assertEqual(kPattern1 | 0x80, mPatterns[2]);
+  assertEqual(kPattern5, mPatterns[3]);
+
+  // NaN is written as spaces.
+  numberWriter.clear();
+  written = numberWriter.writeFloat(NAN);
+  assertEqual(3, written);
+  assertEqual(kPatternSpace, mPatterns[0]);
+}
+
+testF(NumberWriterTest, writeFloat_overflow_uses_exponent) {
+  // "5.00E9" instead of "ovf".
+  wideNumberWriter.home();
+  uint8_t written = wideNumberWriter.writeFloat(5e9);
+  uint8_t* patterns = wideLedModule.getPatterns();
+  assertEqual(5, written);
+  assertEqual(kPattern5 | 0x80, patterns[0]);
+  assertEqual(kPattern0, patterns[1]);
+  assertEqual(kPattern0, patterns[2]);
+  assertEqual(kPatternE, patterns[3]);
+  assertEqual(kPattern9, patterns[4]);
+}
+
+testF(NumberWriterTest, writeFloatExp) {
+  // "1.3E8"
+  uint8_t written = numberWriter.writeFloatExp(1.3e8);
+  assertEqual(4, written);
+  assertEqual(kPattern1 | 0x80, mPatterns[0]);
+  assertEqual(kPattern3, mPatterns[1]);
+  assertEqual(kPatternE, mPatterns[2]);
+  assertEqual(kPattern8, mPatterns[3]);
+
+  // "-2.5E-7"
+  wideNumberWriter.home();
+  written = wideNumberWriter.writeFloatExp(-2.5e-7);
+  uint8_t* patterns = wideLedModule.getPatterns();
+  assertEqual(6, written);
+  assertEqual(kPatternMinus, patterns[0]);
+  assertEqual(kPattern2 | 0x80, patterns[1]);
+  assertEqual(kPattern5, patterns[2]);
+  assertEqual(kPatternE, patterns[3]);
+  assertEqual(kPatternMinus, patterns[4]);
+  assertEqual(kPattern7, patterns[5]);
+
+  // Rounding carries into the exponent: "1.0E1"
+  numberWriter.clear();
+  numberWriter.writeFloatExp(9.96, 1);
+  assertEqual(kPattern1 | 0x80, mPatterns[0]);
+  assertEqual(kPattern0, mPatterns[1]);
+  assertEqual(kPatternE, mPatterns[2]);
+  assertEqual(kPattern1, mPatterns[3]);
+}
+
+testF(NumberWriterTest, writeFloatFit) {
+  // "3.142"
+  uint8_t written = numberWriter.writeFloatFit(3.14159, 4);
+  assertEqual(4, written);
+  assertEqual(kPattern3 | 0x80, mPatterns[0]);
+  assertEqual(kPattern1, mPatterns[1]);
+  assertEqual(kPattern4, mPatterns[2]);
+  assertEqual(kPattern2, mPatterns[3]);
+
+  // "-0.50"
+  numberWriter.clear();
+  numberWriter.writeFloatFit(-0.5, 4);
+  assertEqual(kPatternMinus, mPatterns[0]);
+  assertEqual(kPattern0 | 0x80, mPatterns[1]);
+  assertEqual(kPattern5, mPatterns[2]);
+  assertEqual(kPattern0, mPatterns[3]);
+
+  // Rounding adds an integer digit: "10.00"
+  numberWriter.clear();
+  numberWriter.writeFloatFit(9.9996, 4);
+  assertEqual(kPattern1, mPatterns[0]);
+  assertEqual(kPattern0 | 0x80, mPatterns[1]);
+  assertEqual(kPattern0, mPatterns[2]);
+  assertEqual(kPattern0, mPatterns[3]);
+
+  // Rounding overflows a box without fraction digits: "1.0E4"
+  numberWriter.clear();
+  written = numberWriter.writeFloatFit(9999.6, 4);
+  assertEqual(4, written);
+  assertEqual(kPattern1 | 0x80, mPatterns[0]);
+  assertEqual(kPattern0, mPatterns[1]);
+  assertEqual(kPatternE, mPatterns[2]);
+  assertEqual(kPattern4, mPatterns[3]);
+
+  // "1E2" is the shortest form of 100, and bleeds out of a box of 2.
+  numberWriter.clear();
+  written = numberWriter.writeFloatFit(99.99, 2);
+  assertEqual(3, written);
+  assertEqual(kPattern1, mPatterns[0]);
+  assertEqual(kPatternE, mPatterns[1]);
+  assertEqual(kPattern2, mPatterns[2]);
+
+  // Integer part too large: "1.2E5"
+  numberWriter.clear();
+  written = numberWriter.writeFloatFit(123456, 4);
+  assertEqual(4, written);
+  assertEqual(kPattern1 | 0x80, mPatterns[0]);
+  assertEqual(kPattern2, mPatterns[1]);
+  assertEqual(kPatternE, mPatterns[2]);
+  assertEqual(kPattern5, mPatterns[3]);
+
+  // No significant digits in fixed point: "1E-5"
+  numberWriter.clear();
+  numberWriter.writeFloatFit(0.00001234, 4);
+  assertEqual(kPattern1, mPatterns[0]);
+  assertEqual(kPatternE, mPatterns[1]);
+  assertEqual(kPatternMinus, mPatterns[2]);
+  assertEqual(kPattern5, mPatterns[3]);
+}
+
+// ----------------------------------------------------------------------
+// Exhaustive tests for the division-free decimal conversion.
+// ----------------------------------------------------------------------
+
+test(DecimalConversionTest, div10_uint16_exhaustive) {
+  uint16_t n = 0;
+  do {
+    assertEqual(n / 10, internal::div10(n));
+  } while (++n != 0);
+}
+
+test(DecimalConversionTest, div10_uint8_exhaustive) {
+  uint8_t n = 0;
+  do {
+    assertEqual(n / 10, internal::div10(n));
+  } while (++n != 0);
+}
+
+test(DecimalConversionTest, div100_exhaustive) {
+  for (uint16_t n = 0; n < 10000; n++) {
+    assertEqual(n / 100, internal::div100(n));
+  }
+}
+
+// Render `s` using the same sprintf() conversion and compare it with the
+// patterns written into the wide LED module.
+static bool patternsMatchString(const uint8_t* patterns, const char* s) {
+  uint8_t i = 0;
+  for (; *s; s++, i++) {
+    uint8_t expected = (*s == '-')
+        ? kPatternMinus
+        : pgm_read_byte(&kDigitPatterns[*s - '0']);
+    if (patterns[i] != expected) return false;
+  }
+  for (; i < WIDE_NUM_DIGITS; i++) {
+    if (patterns[i] != 0) return false;
+  }
+  return true;
+}
+
+test(DecimalConversionTest, writeUnsignedDecimal_exhaustive) {
+  uint8_t* patterns = wideLedModule.getPatterns();
+  char buf[8];
+  uint16_t n = 0;
+  do {
+    widePatternWriter.clear();
+    uint8_t written = wideNumberWriter.writeUnsignedDecimal(n);
+    snprintf(buf, sizeof(buf), "%u", (unsigned) n);
+    assertEqual(strlen(buf), written);
+    assertTrue(patternsMatchString(patterns, buf));
+  } while (++n != 0);
+}
+
+test(DecimalConversionTest, writeSignedDecimal_exhaustive) {
+  uint8_t* patterns = wideLedModule.getPatterns();
+  char buf[8];
+  for (int32_t i = -32768; i <= 32767; i++) {
+    int16_t n = i;
+    widePatternWriter.clear();
+    uint8_t written = wideNumberWriter.writeSignedDecimal(n);
+    snprintf(buf, sizeof(buf), "%d", (int) n);
+    assertEqual(strlen(buf), written);
+    assertTrue(patternsMatchString(patterns, buf));
+  }
+}
+
+test(DecimalConversionTest, writeDec4_exhaustive) {
+  uint8_t* patterns = wideLedModule.getPatterns();
+  char buf[8];
+  for (uint16_t n = 0; n < 10000; n++) {
+    widePatternWriter.clear();
+    wideNumberWriter.writeDec4(n);
+    snprintf(buf, sizeof(buf), "%04u", (unsigned) n);
+    assertTrue(patternsMatchString(patterns, buf));
+  }
+}
+
+test(DecimalConversionTest, div10_uint32_sampled) {
+  // Step through the full 32-bit range with a prime stride, checking the
+  // neighbors of each sample which straddle the multiples of 10.
+  uint32_t n = 0;
+  do {
+    for (uint32_t m = n; m < n + 20; m++) {
+      assertEqual(m / 10, internal::div10(m));
+    }
+    n += 65521;
+  } while (n < 0xFFFFFFFF - 65521);
+  assertEqual((uint32_t) 429496729, internal::div10((uint32_t) 0xFFFFFFFF));
+}
+
+test(DecimalConversionTest, toDecimal32_sampled) {
+  const uint8_t bufSize = 10;
+  digit_t buf[bufSize];
+  char expected[12];
+  uint32_t n = 0;
+  do {
+    uint8_t start = internal::toDecimal32(n, buf, bufSize);
+    snprintf(expected, sizeof(expected), "%lu", (unsigned long) n);
+    assertEqual(strlen(expected), (size_t) (bufSize - start));
+    for (uint8_t i = start; i < bufSize; i++) {
+      assertEqual(expected[i - start] - '0', buf[i]);
+    }
+    n += 9973;
+  } while (n < 0xFFFFFFFF - 9973);
+}
+
 // ----------------------------------------------------------------------
 // Tests for ClockWriter.
 // ----------------------------------------------------------------------
@@ -418,6 +2223,355 @@ testF(ClockWriterTest, writeHourMinute24) {
   assertEqual(kPattern4, mPatterns[3]);
 }
 
+test(ClockWriterTest, writeHourMinuteSecond) {
+  uint8_t* patterns = wideLedModule.getPatterns();
+  wideClockWriter.clear();
+  wideClockWriter.writeHourMinuteSecond24(2, 34, 56);
+  assertEqual(kPattern0, patterns[0]);
+  assertEqual(kPattern2 | 0x80, patterns[1]);
+  assertEqual(kPattern3, patterns[2]);
+  assertEqual(kPattern4 | 0x80, patterns[3]);
+  assertEqual(kPattern5, patterns[4]);
+  assertEqual(kPattern6, patterns[5]);
+
+  wideClockWriter.home();
+  wideClockWriter.writeHourMinuteSecond12(2, 34, 56);
+  assertEqual(kPatternSpace, patterns[0]);
+  assertEqual(kPattern2 | 0x80, patterns[1]);
+}
+
+// ----------------------------------------------------------------------
+// Tests for IncrementalClockWriter.
+// ----------------------------------------------------------------------
+
+class IncrementalClockWriterTest: public TestOnce {
+  protected:
+    void setup() override {
+      wideProfiledWriter.clear();
+      secondsClock.invalidate();
+      minutesClock.invalidate();
+      wideProfilingModule.reset();
+      mPatterns = wideProfiledLedModule.getPatterns();
+    }
+
+    const ProfilingStats& stats() { return wideProfilingModule.stats(); }
+
+    uint8_t* mPatterns;
+};
+
+testF(IncrementalClockWriterTest, setTime) {
+  secondsClock.setTime(12, 34, 56);
+  assertEqual(6, stats().numPatterns);
+  assertEqual(kPattern1, mPatterns[0]);
+  assertEqual(kPattern2 | 0x80, mPatterns[1]);
+  assertEqual(kPattern3, mPatterns[2]);
+  assertEqual(kPattern4 | 0x80, mPatterns[3]);
+  assertEqual(kPattern5, mPatterns[4]);
+  assertEqual(kPattern6, mPatterns[5]);
+
+  // Only the minute and second digits differ.
+  wideProfilingModule.reset();
+  secondsClock.setTime(12, 40, 56);
+  assertEqual(4, stats().numPatterns);
+  assertEqual(2, stats().minPos);
+  assertEqual(kPattern4, mPatterns[2]);
+  assertEqual(kPattern0 | 0x80, mPatterns[3]);
+}
+
+testF(IncrementalClockWriterTest, tick_writes_changed_digits) {
+  secondsClock.setTime(12, 34, 56);
+
+  wideProfilingModule.reset();
+  secondsClock.tick(); // 12:34:57
+  assertEqual(1, stats().numPatterns);
+  assertEqual(5, stats().minPos);
+  assertEqual(kPattern7, mPatterns[5]);
+
+  secondsClock.tick(); // 12:34:58
+  secondsClock.tick(); // 12:34:59
+  wideProfilingModule.reset();
+  secondsClock.tick(); // 12:35:00
+  assertEqual(3, stats().numPatterns);
+  assertEqual(3, stats().minPos);
+  assertEqual(kPattern5 | 0x80, mPatterns[3]);
+  assertEqual(kPattern0, mPatterns[4]);
+  assertEqual(kPattern0, mPatterns[5]);
+  assertEqual(35, secondsClock.minute());
+  assertEqual(0, secondsClock.second());
+}
+
+testF(IncrementalClockWriterTest, tick_rolls_over_hour_and_day) {
+  secondsClock.setTime(9, 59, 59);
+  secondsClock.tick();
+  assertEqual(10, secondsClock.hour());
+  assertEqual(kPattern1, mPatterns[0]);
+  assertEqual(kPattern0 | 0x80, mPatterns[1]);
+
+  secondsClock.setTime(23, 59, 59);
+  secondsClock.tick();
+  assertEqual(0, secondsClock.hour());
+  assertEqual(0, secondsClock.minute());
+  assertEqual(kPattern0, mPatterns[0]);
+  assertEqual(kPattern0 | 0x80, mPatterns[1]);
+}
+
+testF(IncrementalClockWriterTest, seconds_not_shown) {
+  minutesClock.setTime(13, 0, 58);
+  assertEqual(4, stats().numPatterns);
+  assertEqual(kPatternSpace, mPatterns[0]); // 12-hour format
+  assertEqual(kPattern1 | 0x80, mPatterns[1]);
+  assertEqual(13, minutesClock.hour());
+
+  // The blank tens digit of the hour is not rewritten.
+  wideProfilingModule.reset();
+  minutesClock.setTime(13, 0, 58);
+  assertFalse(stats().hasWrites());
+
+  minutesClock.tick(); // 1:00:59
+  assertFalse(stats().hasWrites());
+
+  minutesClock.tick(); // 1:01:00
+  assertEqual(1, stats().numPatterns);
+  assertEqual(kPattern1, mPatterns[3]);
+}
+
+testF(IncrementalClockWriterTest, writeColon_does_not_redraw) {
+  secondsClock.setTime(12, 34, 56);
+
+  wideProfilingModule.reset();
+  secondsClock.writeColon(false);
+  assertEqual(0, stats().numPatterns);
+  assertEqual(2, stats().numSetDecimalPointAt);
+  assertEqual(kPattern2, mPatterns[1]);
+  assertEqual(kPattern4, mPatterns[3]);
+
+  // Same state writes nothing.
+  secondsClock.writeColon(false);
+  assertEqual(2, stats().numSetDecimalPointAt);
+
+  // Digits written while the colon is off keep it off.
+  secondsClock.setTime(12, 40, 56);
+  assertEqual(kPattern0, mPatterns[3]);
+  secondsClock.writeColon(true);
+  assertEqual(kPattern0 | 0x80, mPatterns[3]);
+}
+
+// ----------------------------------------------------------------------
+// Tests for CounterWriter.
+// ----------------------------------------------------------------------
+
+class CounterWriterTest: public TestOnce {
+  protected:
+    void setup() override {
+      wideProfiledWriter.clear();
+      counterWriter.invalidate();
+      stopwatchWriter.invalidate();
+      wideProfilingModule.reset();
+      mPatterns = wideProfiledLedModule.getPatterns();
+    }
+
+    const ProfilingStats& stats() { return wideProfilingModule.stats(); }
+
+    uint8_t* mPatterns;
+};
+
+testF(CounterWriterTest, setValue) {
+  counterWriter.setValue(1234);
+  assertEqual((uint32_t) 1234, counterWriter.getValue());
+  assertEqual(4, stats().numPatterns);
+  assertEqual(kPattern1, mPatterns[0]);
+  assertEqual(kPattern4, mPatterns[3]);
+
+  // Only the digits which differ are written. Out of range values wrap.
+  wideProfilingModule.reset();
+  counterWriter.setValue(11299);
+  assertEqual((uint32_t) 1299, counterWriter.getValue());
+  assertEqual(2, stats().numPatterns);
+  assertEqual(2, stats().minPos);
+}
+
+testF(CounterWriterTest, increment_writes_carried_digits) {
+  counterWriter.setValue(1298);
+
+  wideProfilingModule.reset();
+  assertFalse(counterWriter.increment()); // 1299
+  assertEqual(1, stats().numPatterns);
+  assertEqual(3, stats().minPos);
+
+  wideProfilingModule.reset();
+  assertFalse(counterWriter.increment()); // 1300
+  assertEqual(3, stats().numPatterns);
+  assertEqual(1, stats().minPos);
+  assertEqual(kPattern3, mPatterns[1]);
+  assertEqual(kPattern0, mPatterns[3]);
+
+  counterWriter.setValue(9999);
+  assertTrue(counterWriter.increment());
+  assertTrue(counterWriter.isZero());
+  assertEqual(kPattern0, mPatterns[0]);
+}
+
+testF(CounterWriterTest, decrement_writes_borrowed_digits) {
+  counterWriter.setValue(100);
+
+  wideProfilingModule.reset();
+  assertFalse(counterWriter.decrement()); // 0099
+  assertEqual((uint32_t) 99, counterWriter.getValue());
+  assertEqual(3, stats().numPatterns);
+  assertEqual(kPattern9, mPatterns[3]);
+
+  counterWriter.setValue(0);
+  assertTrue(counterWriter.decrement());
+  assertEqual((uint32_t) 9999, counterWriter.getValue());
+}
+
+testF(CounterWriterTest, radixes_and_decimal_points) {
+  stopwatchWriter.setDecimalPoints(0b0101); // after the minute and seconds
+  stopwatchWriter.setValue(599); // 0:59.9
+  assertEqual(1, stats().minPos);
+  assertEqual(kPattern0 | 0x80, mPatterns[1]);
+  assertEqual(kPattern5, mPatterns[2]);
+  assertEqual(kPattern9 | 0x80, mPatterns[3]);
+  assertEqual(kPattern9, mPatterns[4]);
+
+  assertFalse(stopwatchWriter.increment()); // 1:00.0
+  assertEqual((uint32_t) 600, stopwatchWriter.getValue());
+  assertEqual(1, stopwatchWriter.getDigit(0));
+  assertEqual(kPattern1 | 0x80, mPatterns[1]);
+  assertEqual(kPattern0, mPatterns[2]);
+  assertEqual(kPattern0 | 0x80, mPatterns[3]);
+  assertEqual(kPattern0, mPatterns[4]);
+
+  assertFalse(stopwatchWriter.decrement()); // 0:59.9
+  assertEqual((uint32_t) 599, stopwatchWriter.getValue());
+  assertEqual(kPattern5, mPatterns[2]);
+}
+
+// ----------------------------------------------------------------------
+// Tests for CachedNumberWriter and CachedTemperatureWriter.
+// ----------------------------------------------------------------------
+
+class CachedWriterTest: public TestOnce {
+  protected:
+    void setup() override {
+      wideProfiledWriter.clear();
+      leftField.invalidate();
+      rightField.invalidate();
+      temperatureField.invalidate();
+      wideProfilingModule.reset();
+      mPatterns = wideProfiledLedModule.getPatterns();
+    }
+
+    const ProfilingStats& stats() { return wideProfilingModule.stats(); }
+
+    uint8_t* mPatterns;
+};
+
+testF(CachedWriterTest, same_value_is_skipped) {
+  wideProfiledWriter.home();
+  assertEqual(3, leftField.writeSignedDecimal(-12, 3));
+  assertEqual(3, wideProfiledWriter.pos());
+  assertEqual(3, stats().numPatterns);
+
+  // Same arguments: nothing written, the cursor is moved past the field.
+  wideProfilingModule.reset();
+  wideProfiledWriter.home();
+  assertEqual(3, leftField.writeSignedDecimal(-12, 3));
+  assertEqual(3, wideProfiledWriter.pos());
+  assertFalse(stats().hasWrites());
+
+  // A different value, box size or method is written.
+  wideProfiledWriter.home();
+  leftField.writeSignedDecimal(-13, 3);
+  assertEqual(kPattern3, mPatterns[2]);
+  assertTrue(stats().hasWrites());
+
+  wideProfilingModule.reset();
+  wideProfiledWriter.home();
+  leftField.writeSignedDecimal(-13, 4);
+  assertTrue(stats().hasWrites());
+
+  wideProfilingModule.reset();
+  wideProfiledWriter.home();
+  leftField.writeUnsignedDecimal32(65523, 4);
+  assertTrue(stats().hasWrites());
+
+  wideProfilingModule.reset();
+  wideProfiledWriter.home();
+  leftField.writeSignedDecimal32(65523, 4);
+  assertTrue(stats().hasWrites());
+}
+
+testF(CachedWriterTest, fields_are_independent) {
+  wideProfiledWriter.home();
+  leftField.writeUnsignedDecimal(12, 2);
+  rightField.writeFixed(345, 1, 4);
+  assertEqual(kPattern4 | 0x80, mPatterns[4]);
+
+  // Only the right field changed.
+  wideProfilingModule.reset();
+  wideProfiledWriter.home();
+  leftField.writeUnsignedDecimal(12, 2);
+  rightField.writeFixed(346, 1, 4);
+  assertEqual(2, stats().minPos);
+  assertEqual(kPattern6, mPatterns[5]);
+
+  // Same value at another position is written.
+  wideProfilingModule.reset();
+  wideProfiledWriter.pos(1);
+  leftField.writeUnsignedDecimal(12, 2);
+  assertEqual(1, stats().minPos);
+
+  // Same value with different fraction digits is written.
+  wideProfilingModule.reset();
+  wideProfiledWriter.pos(2);
+  rightField.writeFixed(346, 2, 4);
+  assertTrue(stats().hasWrites());
+}
+
+testF(CachedWriterTest, temperature) {
+  wideProfiledWriter.home();
+  assertEqual(4, temperatureField.writeTempDegC(25, 4));
+  assertEqual(kPatternC, mPatterns[3]);
+
+  wideProfilingModule.reset();
+  wideProfiledWriter.home();
+  assertEqual(4, temperatureField.writeTempDegC(25, 4));
+  assertFalse(stats().hasWrites());
+  assertEqual(4, wideProfiledWriter.pos());
+
+  wideProfiledWriter.home();
+  temperatureField.writeTempDegF(25, 4);
+  assertEqual(kPatternF, mPatterns[3]);
+
+  // invalidate() forces the next write.
+  wideProfilingModule.reset();
+  temperatureField.invalidate();
+  wideProfiledWriter.home();
+  temperatureField.writeTempDegF(25, 4);
+  assertTrue(stats().hasWrites());
+}
+
+testF(CachedWriterTest, temperature_tenths) {
+  wideProfiledWriter.home();
+  assertEqual(5, temperatureField.writeTempTenthsDegC(215, 5));
+  assertEqual(kPattern1 | 0x80, mPatterns[1]);
+
+  // Same value in whole degrees or tenths are different formats.
+  wideProfilingModule.reset();
+  wideProfiledWriter.home();
+  temperatureField.writeTempDegC(215, 5);
+  assertTrue(stats().hasWrites());
+
+  wideProfiledWriter.home();
+  temperatureField.writeTempTenthsDegF(707, 5);
+  wideProfilingModule.reset();
+  wideProfiledWriter.home();
+  assertEqual(5, temperatureField.writeTempTenthsDegF(707, 5));
+  assertFalse(stats().hasWrites());
+  assertEqual(5, wideProfiledWriter.pos());
+}
+
 // ----------------------------------------------------------------------
 // Tests for TemperatureWriter.
 // ----------------------------------------------------------------------
@@ -466,6 +2620,86 @@ testF(TemperatureWriterTest, writeTempDegF) {
   assertEqual(kPatternF, mPatterns[3]); // F
 }
 
+testF(TemperatureWriterTest, writeTempTenths) {
+  uint8_t written = temperatureWriter.writeTempTenths(-5 /*tenths*/);
+  assertEqual(3, written);
+  assertEqual(kPatternMinus, mPatterns[0]); // -
+  assertEqual(kPattern0 | 0x80, mPatterns[1]); // 0.
+  assertEqual(kPattern5, mPatterns[2]); // 5
+  assertEqual(3, temperatureWriter.patternWriter().pos());
+
+  temperatureWriter.clear();
+  written = temperatureWriter.writeTempTenthsDeg(215, 4 /*boxSize*/);
+  assertEqual(4, written);
+  assertEqual(kPattern2, mPatterns[0]); // 2
+  assertEqual(kPattern1 | 0x80, mPatterns[1]); // 1.
+  assertEqual(kPattern5, mPatterns[2]); // 5
+  assertEqual(kPatternDeg, mPatterns[3]); // deg
+}
+
+testF(TemperatureWriterTest, writeTempTenthsDegC) {
+  uint8_t written = temperatureWriter.writeTempTenthsDegC(5, 4 /*boxSize*/);
+  assertEqual(4, written);
+  assertEqual(kPattern0 | 0x80, mPatterns[0]); // 0.
+  assertEqual(kPattern5, mPatterns[1]); // 5
+  assertEqual(kPatternDeg, mPatterns[2]); // deg
+  assertEqual(kPatternC, mPatterns[3]); // C
+}
+
+testF(TemperatureWriterTest, writeTempTenthsDegF) {
+  uint8_t written = temperatureWriter.writeTempTenthsDegF(95, 4 /*boxSize*/);
+  assertEqual(4, written);
+  assertEqual(kPattern9 | 0x80, mPatterns[0]); // 9.
+  assertEqual(kPattern5, mPatterns[1]); // 5
+  assertEqual(kPatternDeg, mPatterns[2]); // deg
+  assertEqual(kPatternF, mPatterns[3]); // F
+}
+
+test(TemperatureConversionTest, celsiusToFahrenheitTenths) {
+  assertEqual(320, celsiusToFahrenheitTenths(0));
+  assertEqual(2120, celsiusToFahrenheitTenths(1000));
+  assertEqual(707, celsiusToFahrenheitTenths(215));
+  assertEqual(-400, celsiusToFahrenheitTenths(-400));
+  assertEqual(-4598, celsiusToFahrenheitTenths(-2732));
+
+  // Compare with the rounded floating point conversion, over the range of
+  // temperatures with an exact 5-tenths remainder and without.
+  for (int16_t c = -3000; c <= 18026; c++) {
+    double f = c * 1.8 + 320;
+    int16_t expected = (int16_t) (f >= 0 ? f + 0.5 : f - 0.5);
+    if (celsiusToFahrenheitTenths(c) != expected) {
+      assertEqual(expected, celsiusToFahrenheitTenths(c));
+    }
+  }
+}
+
+test(TemperatureConversionTest, fahrenheitToCelsiusTenths) {
+  assertEqual(0, fahrenheitToCelsiusTenths(320));
+  assertEqual(1000, fahrenheitToCelsiusTenths(2120));
+  assertEqual(215, fahrenheitToCelsiusTenths(707));
+  assertEqual(-400, fahrenheitToCelsiusTenths(-400));
+
+  for (int16_t f = -5000; f <= 30000; f++) {
+    double c = (f - 320) / 1.8;
+    int16_t expected = (int16_t) (c >= 0 ? c + 0.5 : c - 0.5);
+    if (fahrenheitToCelsiusTenths(f) != expected) {
+      assertEqual(expected, fahrenheitToCelsiusTenths(f));
+    }
+  }
+}
+
+test(TemperatureConversionTest, roundTenths) {
+  assertEqual(0, roundTenths(4));
+  assertEqual(1, roundTenths(5));
+  assertEqual(22, roundTenths(215));
+  assertEqual(21, roundTenths(214));
+  assertEqual(0, roundTenths(-4));
+  assertEqual(-1, roundTenths(-5));
+  assertEqual(-22, roundTenths(-215));
+  assertEqual(3277, roundTenths(32767));
+  assertEqual(-3277, roundTenths(-32768));
+}
+
 //-----------------------------------------------------------------------------
 
 void setup() {